@@ -2,15 +2,74 @@
 #define ALGORITIMOS_
 
 #include "grafo.h"
+#include "grafo_matriz.h"
 #include "pilha.h"
+#include "fila_prioridade.h"
+#include "espaco_busca.h"
 
 /* Le tabela para compor o grafo */
 void read_table(grafo_t *grafo, char *table);
 
+/* Le tabela com tempos assimetricos: cada celula vira uma unica aresta da
+ * cidade da linha para a da coluna */
+void read_table_direcionado(grafo_t *grafo, char *table);
+
+/* Opcoes de read_table_opcoes, combinaveis com | */
+#define TABELA_DIRECIONADA  1   /* Como read_table_direcionado */
+#define TABELA_MINUTOS      2   /* Pesos em minutos inteiros: 06.21 vira 381 */
+
+/* Le tabela com as opcoes acima. read_table equivale a opcoes 0 */
+void read_table_opcoes(grafo_t *grafo, char *table, int opcoes);
+
+/* Le tabela diretamente em uma matriz de adjacencia.
+ * Celulas -1 sao arestas ausentes */
+void read_table_matriz(grafo_matriz_t *matriz, char *table);
+
 /* Menor camingo entre todos os nos:
- * retorna um pilha do caminho entre fonte e destino  */
+ * retorna um pilha do caminho entre fonte e destino: o topo e a fonte.
+ * NULL se destino nao for alcancavel */
 pilha_t* Dijkstra(grafo_t *grafo, vertice_t *fonte, vertice_t *destino);
 
+/* Mesmo resultado de Dijkstra, com buscas a partir da fonte e do destino
+ * que se encontram no meio. A busca reversa usa as arestas de entrada,
+ * portanto grafos de read_table_direcionado sao suportados. Nao altera os
+ * vertices */
+pilha_t* dijkstra_bidirecional(grafo_t *grafo, vertice_t *fonte, vertice_t *destino);
+
+/* Distancias de fonte a todos os vertices por delta-stepping paralelo
+ * (ver delta_stepping.h). Preenche dist, pai e antecessor dos vertices como
+ * Dijkstra sem destino; inalcancaveis ficam com dist INFINITY.
+ * num_threads 0 usa uma por nucleo */
+void delta_stepping(grafo_t *grafo, vertice_t *fonte, int num_threads);
+
+/* Menor caminho sem alocacao por vertice: escreve em caminho[0..max) os
+ * vertices de fonte ate destino e retorna o numero de vertices do caminho.
+ * Se o retorno for maior que max, nada e escrito. 0 se inalcancavel */
+int dijkstra_caminho(grafo_t *grafo, vertice_t *fonte, vertice_t *destino,
+                     vertice_t **caminho, int max);
+
+/* Consultas com espaco de busca (ver espaco_busca.h): o estado fica no
+ * espaco do chamador e o grafo nao e alterado, permitindo varias consultas
+ * simultaneas sobre o mesmo grafo, uma por espaco */
+
+/* Dijkstra: dist, pai e aresta de cada vertice ficam no espaco.
+ * destino NULL calcula todas as distancias. Retorna TRUE se alcancou destino */
+int dijkstra_espaco(grafo_t *grafo, vertice_t *fonte, vertice_t *destino,
+                    espaco_busca_t *espaco);
+
+/* Caminho ate destino apos dijkstra_espaco. Mesma convencao de dijkstra_caminho */
+int caminho_espaco(grafo_t *grafo, espaco_busca_t *espaco, vertice_t *destino,
+                   vertice_t **caminho, int max);
+
+/* BFS: dist (saltos) e pai no espaco. Retorna vertices alcancados */
+int bfs_espaco(grafo_t *grafo, vertice_t *inicial, espaco_busca_t *espaco);
+
+/* DFS: visitado e pai no espaco. Retorna vertices visitados */
+int dfs_espaco(grafo_t *grafo, vertice_t *inicial, espaco_busca_t *espaco);
+
+/* Prim: retorna a arvore; a fila usada e a do espaco */
+grafo_t* prim_espaco(grafo_t *grafo, int id, espaco_busca_t *espaco);
+
 /**
   * @brief  Busca em largura
   * @param	grafo: ponteiro do grafo que se deseja executar a busca
@@ -29,6 +88,15 @@ void bfs(grafo_t *grafo, vertice_t* inicial);
   */
 void dfs(grafo_t *grafo, vertice_t* inicial);
 
+/* Arvore geradora minima (Prim) a partir do vertice com identificacao id.
+ * Retorna um novo grafo com as arestas da arvore. Usa heap d-ario */
 grafo_t* prim_algorithm(grafo_t *grafo, int id);
 
+/* Prim com a implementacao de fila de prioridade escolhida */
+grafo_t* prim_algorithm_fila(grafo_t *grafo, int id, tipo_heap_t tipo);
+
+/* Prim O(V^2) sobre matriz de adjacencia: preenche pai[] (indices densos)
+ * e retorna o peso total da arvore */
+float prim_matriz(grafo_matriz_t *matriz, int raiz, int *pai);
+
 #endif
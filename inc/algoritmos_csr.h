@@ -0,0 +1,194 @@
+#ifndef ALGORITMOS_CSR_H_
+#define ALGORITMOS_CSR_H_
+
+#include "grafo_csr.h"
+#include "espaco_busca.h"
+
+/* Algoritmos sobre a fotografia CSR. Vertices sao indices densos e todos os
+ * resultados sao escritos em vetores do chamador com csr_num_vertices
+ * posicoes. pai[v] == -1 indica raiz ou vertice nao alcancado. */
+
+/**
+  * @brief  Busca em largura
+  * @param  csr: grafo
+  * @param  fonte: indice do vertice inicial
+  * @param  dist: recebe o numero de saltos ate a fonte (-1 se inalcancavel)
+  * @param  pai: recebe o antecessor na arvore de busca
+  *
+  * @retval int: numero de vertices alcancados
+  */
+int bfs_csr(grafo_csr_t *csr, int fonte, int *dist, int *pai);
+
+/**
+  * @brief  Busca em largura de direcao otimizada (Beamer et al.)
+  * @param  csr: grafo
+  * @param  transposto: cria_grafo_csr_transposto(csr), ou NULL se o grafo
+  *                     for nao direcionado
+  * @param  fonte: indice do vertice inicial
+  * @param  dist: recebe o numero de saltos ate a fonte (-1 se inalcancavel)
+  * @param  pai: recebe o antecessor na arvore de busca
+  *
+  * Fronteiras pequenas expandem as arestas de saida (de cima para baixo).
+  * Fronteiras grandes sao testadas a partir dos vertices nao visitados, que
+  * param no primeiro predecessor na fronteira (de baixo para cima), o que
+  * evita examinar a maior parte das arestas em grafos densos. Visitados e
+  * fronteira ficam em mapas de bits. As distancias sao as mesmas de bfs_csr;
+  * os pais podem diferir entre antecessores de mesmo nivel.
+  *
+  * @retval int: numero de vertices alcancados
+  */
+int bfs_csr_direcional(grafo_csr_t *csr, grafo_csr_t *transposto, int fonte,
+                       int *dist, int *pai);
+
+/**
+  * @brief  Busca em largura paralela, sincronizada por nivel
+  * @param  csr: grafo
+  * @param  fonte: indice do vertice inicial
+  * @param  dist: recebe o numero de saltos ate a fonte (-1 se inalcancavel)
+  * @param  pai: recebe o antecessor na arvore de busca
+  * @param  num_threads: numero de threads (0: uma por nucleo)
+  *
+  * Cada nivel e dividido entre as threads. Um vertice pertence a quem
+  * primeiro ligar o seu bit no mapa de visitados (test-and-set atomico); os
+  * descobertos vao para buffers por tarefa, concatenados na proxima
+  * fronteira. Distancias iguais as de bfs_csr; os pais podem diferir entre
+  * antecessores de mesmo nivel.
+  *
+  * @retval int: numero de vertices alcancados
+  */
+int bfs_csr_paralelo(grafo_csr_t *csr, int fonte, int *dist, int *pai, int num_threads);
+
+/**
+  * @brief  Busca em profundidade
+  * @param  csr: grafo
+  * @param  fonte: indice do vertice inicial
+  * @param  ordem: recebe os vertices na ordem de descoberta
+  * @param  pai: recebe o antecessor na arvore de busca
+  *
+  * @retval int: numero de vertices alcancados (posicoes escritas em ordem)
+  */
+int dfs_csr(grafo_csr_t *csr, int fonte, int *ordem, int *pai);
+
+/* Funcoes chamadas durante a busca em profundidade. Qualquer uma pode ser
+ * NULL. Permitem calcular, na mesma passada, articulacoes, pontes,
+ * componentes biconexos, ordem topologica etc. */
+typedef struct visitante_dfs
+{
+    void *contexto;
+
+    /* v foi descoberto a partir de pai (-1 na raiz): inicio da pre-ordem */
+    void (*descoberta)(void *contexto, int v, int pai);
+
+    /* Aresta de posicao k (u -> w) cujo destino ja havia sido descoberto:
+     * retorno, avanco ou cruzamento. Em grafos nao direcionados inclui a
+     * aresta de volta ao pai; use k para distinguir arestas paralelas */
+    void (*aresta)(void *contexto, int u, int w, int k);
+
+    /* Todas as arestas de v foram examinadas: pos-ordem */
+    void (*termino)(void *contexto, int v, int pai);
+} visitante_dfs_t;
+
+/**
+  * @brief  Busca em profundidade iterativa com visitante
+  * @param  csr: grafo
+  * @param  fonte: indice do vertice inicial, ou -1 para percorrer todos os
+  *                vertices (floresta de busca, raizes em ordem de indice)
+  * @param  pre: recebe os vertices em ordem de descoberta. Pode ser NULL
+  * @param  pos: recebe os vertices em ordem de termino. Pode ser NULL
+  * @param  pai: recebe o pai na arvore de busca (-1 nas raizes). Pode ser NULL
+  * @param  visitante: funcoes chamadas a cada evento. Pode ser NULL
+  *
+  * Pilha em vetor de n posicoes e um cursor de aresta por vertice, que
+  * retoma a lista de adjacencia de onde parou; nenhuma alocacao por vertice.
+  *
+  * @retval int: numero de vertices alcancados
+  */
+int dfs_csr_visitante(grafo_csr_t *csr, int fonte, int *pre, int *pos, int *pai,
+                      visitante_dfs_t *visitante);
+
+/**
+  * @brief  Arvore geradora minima (Prim) do componente da raiz
+  * @param  csr: grafo nao direcionado
+  * @param  raiz: indice do vertice raiz
+  * @param  pai: recebe o pai de cada vertice na arvore
+  * @param  peso: recebe o peso da aresta (pai[v], v). Pode ser NULL
+  *
+  * @retval float: peso total da arvore
+  */
+float prim_csr(grafo_csr_t *csr, int raiz, int *pai, float *peso);
+
+/**
+  * @brief  Menores caminhos (Dijkstra) com parada antecipada
+  * @param  csr: grafo com pesos nao negativos
+  * @param  fonte: indice do vertice de origem
+  * @param  destino: indice do destino, ou -1 para todos os vertices
+  * @param  dist: recebe as distancias (INFINITY se inalcancavel)
+  * @param  pai: recebe o antecessor no menor caminho
+  *
+  * @retval float: distancia ate destino (0 se destino == -1)
+  */
+float dijkstra_csr(grafo_csr_t *csr, int fonte, int destino, float *dist, int *pai);
+
+/* Variantes com espaco de busca (ver espaco_busca.h): nao alocam memoria e
+ * deixam dist e pai no espaco, que deve ter ao menos csr_num_vertices
+ * posicoes. Com um espaco por thread, varias consultas podem correr ao mesmo
+ * tempo sobre a mesma fotografia. */
+
+/* BFS: dist recebe o numero de saltos. Retorna vertices alcancados */
+int bfs_csr_espaco(grafo_csr_t *csr, int fonte, espaco_busca_t *espaco);
+
+/* Prim: dist recebe o peso da aresta (pai, v). Retorna o peso total */
+float prim_csr_espaco(grafo_csr_t *csr, int raiz, espaco_busca_t *espaco);
+
+/* Dijkstra com parada antecipada. Retorna a distancia ate destino
+ * (0 se destino == -1) */
+float dijkstra_csr_espaco(grafo_csr_t *csr, int fonte, int destino,
+                          espaco_busca_t *espaco);
+
+/**
+  * @brief  Reconstroi o caminho ate destino a partir dos pais no espaco
+  * @param  espaco: estado de dijkstra_csr_espaco ou bfs_csr_espaco
+  * @param  destino: indice do vertice final
+  * @param  caminho: recebe os indices da fonte ate destino
+  * @param  max: capacidade de caminho
+  *
+  * @retval int: numero de vertices do caminho, 0 se inalcancavel.
+  *              Se maior que max, caminho nao e escrito.
+  */
+int caminho_csr_espaco(espaco_busca_t *espaco, int destino, int *caminho, int max);
+
+/**
+  * @brief  Dijkstra bidirecional entre dois vertices
+  * @param  csr: grafo com pesos nao negativos
+  * @param  transposto: cria_grafo_csr_transposto(csr), ou NULL se o grafo
+  *                     for nao direcionado
+  * @param  fonte, destino: indices dos extremos
+  * @param  frente, tras: espacos distintos para as buscas a partir de
+  *                       fonte (em csr) e de destino (em transposto)
+  * @param  encontro: recebe o vertice onde os caminhos se unem
+  *
+  * A cada passo avanca o sentido cujo menor rotulo na fila e o menor. O
+  * custo do melhor caminho completo conhecido e mantido ao relaxar as
+  * arestas; a busca para quando a soma dos minimos das duas filas o
+  * alcanca, pois nenhum caminho ainda nao visto pode ser mais curto.
+  *
+  * @retval float: distancia de fonte a destino (INFINITY se inalcancavel)
+  */
+float dijkstra_csr_bidirecional(grafo_csr_t *csr, grafo_csr_t *transposto,
+                                int fonte, int destino, espaco_busca_t *frente,
+                                espaco_busca_t *tras, int *encontro);
+
+/**
+  * @brief  Reconstroi o caminho de dijkstra_csr_bidirecional
+  * @param  frente, tras: espacos usados na busca
+  * @param  encontro: vertice de encontro devolvido pela busca
+  * @param  caminho: recebe os indices da fonte ate destino
+  * @param  max: capacidade de caminho
+  *
+  * @retval int: numero de vertices do caminho, 0 se inalcancavel.
+  *              Se maior que max, caminho nao e escrito.
+  */
+int caminho_csr_bidirecional(espaco_busca_t *frente, espaco_busca_t *tras,
+                             int encontro, int *caminho, int max);
+
+#endif /* ALGORITMOS_CSR_H_ */
@@ -0,0 +1,54 @@
+/*
+ * algoritmos_inteiros.h
+ *
+ * Menores caminhos e arvore geradora com pesos inteiros pequenos, como os
+ * minutos de read_table_opcoes(..., TABELA_MINUTOS). Com chaves inteiras a
+ * fila de prioridade pode ser uma fila de baldes, sem comparacoes:
+ *
+ *   - Dial: C + 1 baldes circulares, C o maior peso. Dijkstra so extrai
+ *     chaves em [d, d + C], portanto cada chave tem um balde proprio.
+ *   - Heap radix: 33 baldes pelo bit mais alto em que a chave difere do
+ *     ultimo minimo. Cada item desce no maximo 32 baldes, o que independe
+ *     de C e evita os baldes vazios de Dial quando C e grande.
+ *
+ * Os grafos devem ter csr_pesos_inteiros. Distancias inalcancaveis sao -1.
+ */
+
+#ifndef ALGORITMOS_INTEIROS_H_
+#define ALGORITMOS_INTEIROS_H_
+
+#include "grafo_csr.h"
+
+/**
+  * @brief  Dijkstra com a fila de baldes de Dial
+  * @param  csr: grafo com pesos inteiros
+  * @param  fonte: indice do vertice de origem
+  * @param  destino: indice do destino, ou -1 para todos os vertices
+  * @param  dist: recebe as distancias (-1 se inalcancavel)
+  * @param  pai: recebe o antecessor no menor caminho (-1 na fonte)
+  *
+  * O(m + D), D a distancia do vertice mais distante extraido.
+  *
+  * @retval int: distancia ate destino (-1 se inalcancavel, 0 se destino == -1)
+  */
+int dijkstra_csr_dial(grafo_csr_t *csr, int fonte, int destino, int *dist, int *pai);
+
+/* Dijkstra com heap radix: mesmos parametros e resultado de
+ * dijkstra_csr_dial, em O(m + n log C) */
+int dijkstra_csr_radix(grafo_csr_t *csr, int fonte, int destino, int *dist, int *pai);
+
+/**
+  * @brief  Arvore geradora minima (Prim) com baldes indexados pelo peso
+  * @param  csr: grafo nao direcionado com pesos inteiros
+  * @param  raiz: indice do vertice raiz
+  * @param  pai: recebe o pai de cada vertice na arvore (-1 fora dela)
+  * @param  peso: recebe o peso da aresta (pai[v], v). Pode ser NULL
+  *
+  * As chaves de Prim nao sao monotonas, entao os baldes nao giram: o
+  * cursor volta sempre que uma chave cai abaixo dele. O(m + n C).
+  *
+  * @retval int: peso total da arvore
+  */
+int prim_csr_baldes(grafo_csr_t *csr, int raiz, int *pai, int *peso);
+
+#endif /* ALGORITMOS_INTEIROS_H_ */
@@ -0,0 +1,77 @@
+/*
+ * alt.h
+ *
+ * Consultas ponto a ponto por A* com marcos e desigualdade triangular (ALT,
+ * Goldberg e Harrelson). Um pre-processamento escolhe alguns vertices
+ * marcos e guarda a distancia de e para cada um deles; na consulta,
+ *
+ *   d(v, t) >= d(L, t) - d(L, v)   e   d(v, t) >= d(v, L) - d(t, L)
+ *
+ * dao um limite inferior admissivel e consistente que orienta a busca
+ * em direcao ao destino.
+ *
+ * A tabela de marcos pode ser gravada ao lado da tabela de tempos e
+ * reaberta com mmap, sem refazer o pre-processamento.
+ */
+
+#ifndef ALT_H_
+#define ALT_H_
+
+#include "grafo_csr.h"
+#include "espaco_busca.h"
+
+typedef struct alt alt_t;
+
+/* Numero de marcos sugerido: acima disso o custo do limite em cada vertice
+ * passa a pesar mais que os vertices poupados */
+#define ALT_MARCOS_PADRAO 8
+
+/**
+  * @brief  Escolhe os marcos e calcula as distancias
+  * @param  csr: grafo com pesos nao negativos
+  * @param  transposto: cria_grafo_csr_transposto(csr), ou NULL se o grafo
+  *                     for nao direcionado
+  * @param  num_marcos: numero de marcos (no maximo csr_num_vertices)
+  * @param  num_threads: numero de threads (0: uma por nucleo)
+  *
+  * Selecao pelo mais distante: o primeiro marco e o vertice mais distante
+  * do vertice 0; cada novo marco e o vertice mais distante dos ja
+  * escolhidos. Vertices inalcancaveis sao os mais distantes, de modo que
+  * cada componente recebe marcos.
+  *
+  * @retval alt_t: tabela de marcos em memoria
+  */
+alt_t *cria_alt(grafo_csr_t *csr, grafo_csr_t *transposto, int num_marcos, int num_threads);
+
+/* Grava a tabela e os ids dos vertices em arquivo binario */
+void salva_alt(alt_t *alt, const char *arquivo);
+
+/* Abre um arquivo de salva_alt com mmap, somente leitura. Os ids devem
+ * coincidir com os do csr, para evitar o uso de uma tabela desatualizada */
+alt_t *carrega_alt(const char *arquivo, grafo_csr_t *csr);
+
+int alt_num_marcos(alt_t *alt);
+
+/* Indice do i-esimo marco */
+int alt_marco(alt_t *alt, int i);
+
+/* Limite inferior de d(u, v). INFINITY se os marcos provam que v e
+ * inalcancavel a partir de u */
+float alt_limite(alt_t *alt, int u, int v);
+
+/**
+  * @brief  Menor caminho por A* com os limites dos marcos
+  * @param  alt: tabela de marcos do mesmo grafo
+  * @param  csr: grafo
+  * @param  fonte, destino: indices dos extremos
+  * @param  espaco: recebe dist e pai, como dijkstra_csr_espaco; o caminho
+  *                 e obtido com caminho_csr_espaco
+  *
+  * @retval float: distancia de fonte a destino (INFINITY se inalcancavel)
+  */
+float alt_consulta(alt_t *alt, grafo_csr_t *csr, int fonte, int destino,
+                   espaco_busca_t *espaco);
+
+void libera_alt(alt_t *alt);
+
+#endif /* ALT_H_ */
@@ -0,0 +1,34 @@
+#ifndef ARENA_H_INCLUDED
+#define ARENA_H_INCLUDED
+
+#include <stddef.h>
+
+/* Arena: alocacao sequencial em blocos grandes. Nao ha liberacao individual;
+ * toda a memoria e devolvida de uma vez por libera_arena. */
+typedef struct arenas arena_t;
+
+/* Pool (slab) de objetos de tamanho fixo, alocado dentro de uma arena.
+ * Objetos do mesmo pool ficam contiguos e, como na arena, so sao
+ * devolvidos por libera_arena. */
+typedef struct pools pool_t;
+
+/* Cria uma arena com blocos de tamanho_bloco bytes (0: tamanho padrao) */
+arena_t *cria_arena(size_t tamanho_bloco);
+
+/* Aloca tamanho bytes alinhados para qualquer tipo */
+void *arena_aloca(arena_t *arena, size_t tamanho);
+
+/* Copia uma string para a arena */
+char *arena_copia_string(arena_t *arena, const char *texto);
+
+/* Libera todos os blocos e pools da arena */
+void libera_arena(arena_t *arena);
+
+/* Cria um pool de objetos de tamanho_objeto bytes, alocados em slabs de
+ * objetos_por_slab objetos */
+pool_t *cria_pool(arena_t *arena, size_t tamanho_objeto, int objetos_por_slab);
+
+/* Obtem um objeto do pool */
+void *pool_aloca(pool_t *pool);
+
+#endif // ARENA_H_INCLUDED
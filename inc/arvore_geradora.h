@@ -0,0 +1,63 @@
+/*
+ * arvore_geradora.h
+ *
+ * Arvores geradoras minimas por arestas (Kruskal e Boruvka). O resultado tem
+ * o mesmo formato de prim_algorithm (ver algoritimos.h): um novo grafo_t com
+ * uma aresta por ligacao da arvore, podendo ser comparado diretamente.
+ * Em grafos desconexos o resultado e a floresta geradora minima.
+ *
+ * Empates de peso sao desfeitos pelos indices (u, v) das pontas; com essa
+ * ordem total a arvore e unica e todos os algoritmos daqui a produzem igual,
+ * assim como prim_algorithm, que desempata a fila por desempate_aresta.
+ */
+
+#ifndef ARVORE_GERADORA_H_
+#define ARVORE_GERADORA_H_
+
+#include <stdint.h>
+
+#include "grafo.h"
+
+/* Desempate de arestas de mesmo peso pelos indices das pontas: a ordem de
+ * (peso, desempate_aresta(u, v)) e a mesma de Kruskal e Boruvka */
+uint64_t desempate_aresta(int u, int v);
+
+typedef enum modo_kruskal
+{
+    KRUSKAL_ORDENACAO,  /*!< Ordena todas as arestas (ordenacao paralela) */
+    KRUSKAL_FILTRO      /*!< Filter-Kruskal: particiona pelo peso e descarta,
+                             sem ordenar, arestas que ja fecham ciclos */
+} modo_kruskal_t;
+
+/* Kruskal com ordenacao paralela usando todos os nucleos */
+grafo_t *kruskal_algorithm(grafo_t *grafo);
+
+/* Kruskal no modo escolhido com ate num_threads threads (0: uma por nucleo) */
+grafo_t *kruskal_algorithm_modo(grafo_t *grafo, modo_kruskal_t modo, int num_threads);
+
+/* Floresta geradora minima: uma arvore por componente conexo */
+typedef struct floresta
+{
+    grafo_t *arvores;       /*!< Todos os vertices do grafo, na mesma ordem de
+                                 indices, e as arestas de todas as arvores */
+    int num_componentes;
+    float *totais;          /*!< Peso total da arvore de cada componente */
+    int *tamanhos;          /*!< Numero de vertices de cada componente */
+    int *raizes;            /*!< id da raiz (vertice de menor indice) */
+} floresta_t;
+
+/* Rotula os componentes (id_grupo dos vertices do grafo, ver
+ * componentes_conexos) e executa Prim em cada um, com ate num_threads
+ * componentes ao mesmo tempo (0: um por nucleo). Componente c tem raiz
+ * raizes[c] e sua arvore e a mesma de prim_algorithm(grafo, raizes[c]). */
+floresta_t *floresta_geradora_minima(grafo_t *grafo, int num_threads);
+
+void libera_floresta(floresta_t *floresta);
+
+/* Boruvka paralelo usando todos os nucleos */
+grafo_t *boruvka_algorithm(grafo_t *grafo);
+
+/* Boruvka paralelo com ate num_threads threads (0: uma por nucleo) */
+grafo_t *boruvka_algorithm_threads(grafo_t *grafo, int num_threads);
+
+#endif /* ARVORE_GERADORA_H_ */
@@ -0,0 +1,51 @@
+/*
+ * componentes.h
+ *
+ * Componentes conexos de um grafo nao direcionado. Depois do calculo,
+ * perguntar se dois vertices se alcancam, o tamanho ou os vertices de um
+ * componente sao consultas O(1), sem percorrer o grafo.
+ *
+ * Os componentes sao numerados de 0 em diante na ordem do menor indice de
+ * vertice de cada um, qualquer que seja o metodo. id_grupo de cada vertice
+ * do grafo recebe o numero do seu componente (ver vertice_get_grupo).
+ */
+
+#ifndef COMPONENTES_H_
+#define COMPONENTES_H_
+
+#include "grafo.h"
+
+typedef struct componentes componentes_t;
+
+typedef enum metodo_componentes
+{
+    COMPONENTES_UNIAO,      /*!< Union-find sobre as arestas, sequencial */
+    COMPONENTES_PROPAGACAO  /*!< Propagacao do menor rotulo, paralela */
+} metodo_componentes_t;
+
+/* Componentes pelo union-find */
+componentes_t *componentes_conexos(grafo_t *grafo);
+
+/* Componentes pelo metodo escolhido. num_threads so e usado pela
+ * propagacao (0: uma por nucleo) */
+componentes_t *componentes_conexos_metodo(grafo_t *grafo, metodo_componentes_t metodo,
+                                          int num_threads);
+
+int componentes_num(componentes_t *componentes);
+
+/* Componente do vertice de indice v */
+int componentes_rotulo(componentes_t *componentes, int v);
+
+/* TRUE se os vertices de indices u e v estao no mesmo componente */
+int componentes_alcancavel(componentes_t *componentes, int u, int v);
+
+/* Numero de vertices do componente c */
+int componentes_tamanho(componentes_t *componentes, int c);
+
+/* Indices dos vertices do componente c, em ordem crescente
+ * (componentes_tamanho posicoes, somente leitura) */
+const int *componentes_vertices(componentes_t *componentes, int c);
+
+void libera_componentes(componentes_t *componentes);
+
+#endif /* COMPONENTES_H_ */
@@ -0,0 +1,31 @@
+#ifndef CONJUNTO_DISJUNTO_H_INCLUDED
+#define CONJUNTO_DISJUNTO_H_INCLUDED
+
+/* Conjuntos disjuntos (union-find) sobre os elementos [0, n), com
+ * compressao de caminho e uniao por posto: operacoes em tempo
+ * praticamente constante (inversa de Ackermann). */
+typedef struct conjuntos_disjuntos conjunto_disjunto_t;
+
+/* Cria n conjuntos unitarios */
+conjunto_disjunto_t *cria_conjunto_disjunto(int n);
+
+/* Representante do conjunto que contem x */
+int conjunto_encontrar(conjunto_disjunto_t *conjuntos, int x);
+
+/* Une os conjuntos de a e b.
+ * Retorna TRUE se estavam separados, FALSE se ja eram o mesmo conjunto */
+int conjunto_unir(conjunto_disjunto_t *conjuntos, int a, int b);
+
+/* Versoes seguras para chamadas simultaneas de varias threads, sem trava.
+ * A uniao pendura o representante de maior indice no de menor, ignorando o
+ * posto; encontrar usa divisao de caminho (path halving). Nao misturar com
+ * as versoes sequenciais enquanto houver threads operando. */
+int conjunto_encontrar_concorrente(conjunto_disjunto_t *conjuntos, int x);
+int conjunto_unir_concorrente(conjunto_disjunto_t *conjuntos, int a, int b);
+
+/* Numero de conjuntos distintos */
+int conjunto_num_conjuntos(conjunto_disjunto_t *conjuntos);
+
+void libera_conjunto_disjunto(conjunto_disjunto_t *conjuntos);
+
+#endif // CONJUNTO_DISJUNTO_H_INCLUDED
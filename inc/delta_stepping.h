@@ -0,0 +1,43 @@
+/*
+ * delta_stepping.h
+ *
+ * Menores caminhos a partir de uma fonte por delta-stepping (Meyer e
+ * Sanders). As distancias provisorias ficam em baldes de largura delta e
+ * todos os vertices do menor balde sao relaxados em paralelo: primeiro as
+ * arestas leves (peso <= delta), que podem reinserir vertices no mesmo
+ * balde, e depois, uma unica vez, as pesadas. delta pequeno se aproxima de
+ * Dijkstra; delta grande, de Bellman-Ford.
+ */
+
+#ifndef DELTA_STEPPING_H_
+#define DELTA_STEPPING_H_
+
+#include "grafo_csr.h"
+
+/* Delta automatico: maior peso dividido pelo grau medio, de modo que cada
+ * vertice tenha em media uma aresta leve por balde */
+float delta_stepping_delta(grafo_csr_t *csr);
+
+/**
+  * @brief  Distancias de fonte a todos os vertices
+  * @param  csr: grafo com pesos nao negativos, dirigido ou nao
+  * @param  fonte: indice do vertice de origem
+  * @param  delta: largura dos baldes, positiva e finita (ex.:
+  *                delta_stepping_delta). Pequena demais para os baldes
+  *                caberem na memoria ou para a precisao das distancias,
+  *                e alargada
+  * @param  num_threads: numero de threads (0: uma por nucleo)
+  * @param  dist: recebe as distancias (INFINITY se inalcancavel)
+  * @param  pai: recebe o antecessor no menor caminho (-1 na fonte e nos
+  *              inalcancaveis)
+  *
+  * As distancias sao as de dijkstra_csr. Como em Dijkstra, o antecessor e
+  * o primeiro a alcancar a distancia final; entre caminhos empatados a
+  * escolha pode variar de uma execucao para outra.
+  *
+  * @retval Nenhum
+  */
+void delta_stepping_csr(grafo_csr_t *csr, int fonte, float delta, int num_threads,
+                        float *dist, int *pai);
+
+#endif /* DELTA_STEPPING_H_ */
@@ -0,0 +1,56 @@
+/*
+ * distancias.h
+ *
+ * Matriz de menores distancias entre todos os pares de vertices (APSP),
+ * calculada com um Dijkstra por origem em paralelo. A matriz e densa, em
+ * ordem de linhas (linha = origem), indexada pelos indices do CSR.
+ *
+ * A matriz pode ser gravada em arquivo e reaberta com mmap: a consulta e
+ * um acesso a memoria, sem recalcular nem ler o arquivo inteiro.
+ */
+
+#ifndef DISTANCIAS_H_
+#define DISTANCIAS_H_
+
+#include "grafo_csr.h"
+
+typedef struct distancias distancias_t;
+
+typedef enum formato_distancias
+{
+    DISTANCIAS_FLOAT32, /*!< 4 bytes por par, distancia exata */
+    DISTANCIAS_UINT16   /*!< 2 bytes por par: distancia * escala, arredondada */
+} formato_distancias_t;
+
+/* Valor de DISTANCIAS_UINT16 para pares inalcancaveis */
+#define DISTANCIAS_UINT16_INFINITO 65535
+
+/* Calcula a matriz com ate num_threads threads (0: uma por nucleo).
+ * escala: usada apenas em DISTANCIAS_UINT16 (ex.: 60 para horas -> minutos).
+ * Distancias que nao cabem em 16 bits sao erro */
+distancias_t *calcula_distancias(grafo_csr_t *csr, formato_distancias_t formato,
+                                 float escala, int num_threads);
+
+/* Grava a matriz e os ids dos vertices em arquivo binario */
+void salva_distancias(distancias_t *distancias, const char *arquivo);
+
+/* Abre um arquivo de salva_distancias com mmap, somente leitura */
+distancias_t *carrega_distancias(const char *arquivo);
+
+int distancias_num_vertices(distancias_t *distancias);
+formato_distancias_t distancias_formato(distancias_t *distancias);
+
+/* Indice do vertice com identificacao id. -1 se nao existir */
+int distancias_indice(distancias_t *distancias, int id);
+
+/* Distancia de u a v (indices). INFINITY se inalcancavel. Em
+ * DISTANCIAS_UINT16 o valor e convertido de volta pela escala */
+float distancias_consulta(distancias_t *distancias, int u, int v);
+
+/* Linha da origem u, para varreduras: const float* ou const uint16_t*
+ * conforme o formato */
+const void *distancias_linha(distancias_t *distancias, int u);
+
+void libera_distancias(distancias_t *distancias);
+
+#endif /* DISTANCIAS_H_ */
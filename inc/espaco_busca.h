@@ -0,0 +1,49 @@
+#ifndef ESPACO_BUSCA_H_INCLUDED
+#define ESPACO_BUSCA_H_INCLUDED
+
+#include "vertice.h"
+#include "fila_prioridade.h"
+
+/* Estado de uma consulta (busca, Prim, Dijkstra) separado dos vertices.
+ * Vetores densos indexados pelo indice do vertice (vertice_get_indice).
+ *
+ * O reinicio e O(1): cada vertice guarda a geracao em que foi tocado e
+ * qualquer valor de geracao anterior equivale ao estado inicial
+ * (nao visitado, distancia INFINITY, sem pai e sem aresta).
+ *
+ * Cada thread deve possuir o seu espaco; o grafo pode ser compartilhado
+ * desde que nao seja alterado durante as consultas. */
+typedef struct espacos_busca espaco_busca_t;
+
+/* Cria um espaco para grafos de ate n vertices.
+ * tipo: implementacao da fila de prioridade interna */
+espaco_busca_t *cria_espaco_busca(int n, tipo_heap_t tipo);
+
+void libera_espaco_busca(espaco_busca_t *espaco);
+
+/* Descarta o estado da consulta anterior em O(1) */
+void espaco_reinicia(espaco_busca_t *espaco);
+
+int espaco_num_vertices(espaco_busca_t *espaco);
+
+int espaco_visitado(espaco_busca_t *espaco, int v);
+void espaco_visita(espaco_busca_t *espaco, int v);
+
+float espaco_get_dist(espaco_busca_t *espaco, int v);
+void espaco_set_dist(espaco_busca_t *espaco, int v, float dist);
+
+/* Indice do antecessor de v. -1 se nao houver */
+int espaco_get_pai(espaco_busca_t *espaco, int v);
+void espaco_set_pai(espaco_busca_t *espaco, int v, int pai);
+
+/* Aresta pela qual v foi alcancado. NULL se nao houver */
+arestas_t *espaco_get_aresta(espaco_busca_t *espaco, int v);
+void espaco_set_aresta(espaco_busca_t *espaco, int v, arestas_t *aresta);
+
+/* Memoria de trabalho reutilizada entre consultas (n posicoes cada):
+ * fila de prioridade vazia, vetor de indices e vetor de cursores de lista */
+fila_prioridade_t *espaco_fila_prioridade(espaco_busca_t *espaco);
+int *espaco_vetor(espaco_busca_t *espaco);
+no_t **espaco_cursores(espaco_busca_t *espaco);
+
+#endif // ESPACO_BUSCA_H_INCLUDED
@@ -1,14 +1,22 @@
 #ifndef FILA_H_INCLUDED
 #define FILA_H_INCLUDED
 
+/* Fila generica em buffer circular contiguo. A capacidade e potencia de
+ * dois e dobra quando cheia; enqueue/dequeue nao alocam memoria enquanto
+ * houver espaco */
 typedef struct filas fila_t;
 
 fila_t * cria_fila (void);
 
+/* Cria a fila ja com espaco para capacidade dados, evitando realocacoes
+ * quando o numero maximo de elementos e conhecido (ex.: vertices do grafo) */
+fila_t * cria_fila_tamanho (int capacidade);
+
 void enqueue(void *dado, fila_t *fila);
 void* dequeue(fila_t *fila);
 
 int fila_vazia(fila_t *fila);
+int fila_tamanho(fila_t *fila);
 void libera_fila(fila_t* fila);
 
 #endif // FILA_H_INCLUDED
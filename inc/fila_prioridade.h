@@ -0,0 +1,60 @@
+#ifndef FILA_PRIORIDADE_H_INCLUDED
+#define FILA_PRIORIDADE_H_INCLUDED
+
+#include <stdint.h>
+
+/* Fila de prioridade indexada (min-heap) com suporte a decrease-key.
+ * As chaves sao inteiros densos no intervalo [0, capacidade), normalmente
+ * o indice do vertice no grafo (ver vertice_get_indice). */
+typedef struct filas_prioridade fila_prioridade_t;
+
+/* Implementacao interna da fila */
+typedef enum tipo_heap { HEAP_DARIO, HEAP_PAREAMENTO } tipo_heap_t;
+
+/* Aridade padrao do heap d-ario */
+#define FILA_PRIORIDADE_ARIDADE 4
+
+/* Cria uma fila para chaves [0, capacidade).
+ * aridade: numero de filhos por no do heap d-ario (ignorado no pairing heap) */
+fila_prioridade_t *cria_fila_prioridade(int capacidade, tipo_heap_t tipo, int aridade);
+
+/* Insere uma chave ausente com a prioridade dada */
+void fila_prioridade_inserir(fila_prioridade_t *fila, int chave, float prioridade);
+
+/* Diminui a prioridade de uma chave presente na fila */
+void fila_prioridade_diminuir(fila_prioridade_t *fila, int chave, float prioridade);
+
+/* Insere a chave ou diminui sua prioridade.
+ * Retorna TRUE se a fila foi alterada */
+int fila_prioridade_atualizar(fila_prioridade_t *fila, int chave, float prioridade);
+
+/* Variantes que desempatam prioridades iguais pelo menor desempate, como
+ * a ordem (peso, u, v) de arvores geradoras. As funcoes acima usam
+ * desempate 0 */
+void fila_prioridade_inserir_desempate(fila_prioridade_t *fila, int chave, float prioridade,
+                                       uint64_t desempate);
+void fila_prioridade_diminuir_desempate(fila_prioridade_t *fila, int chave, float prioridade,
+                                        uint64_t desempate);
+int fila_prioridade_atualizar_desempate(fila_prioridade_t *fila, int chave, float prioridade,
+                                        uint64_t desempate);
+
+/* Chave de menor prioridade, sem remove-la.
+ * prioridade: se nao for NULL recebe a sua prioridade */
+int fila_prioridade_minimo(fila_prioridade_t *fila, float *prioridade);
+
+/* Remove a chave de menor prioridade.
+ * prioridade: se nao for NULL recebe a prioridade da chave removida */
+int fila_prioridade_remover_min(fila_prioridade_t *fila, float *prioridade);
+
+/* Retorna TRUE se a chave estiver na fila */
+int fila_prioridade_contem(fila_prioridade_t *fila, int chave);
+
+int fila_prioridade_vazia(fila_prioridade_t *fila);
+int fila_prioridade_tamanho(fila_prioridade_t *fila);
+
+/* Esvazia a fila para reutilizacao, sem liberar memoria */
+void fila_prioridade_limpar(fila_prioridade_t *fila);
+
+void libera_fila_prioridade(fila_prioridade_t *fila);
+
+#endif // FILA_PRIORIDADE_H_INCLUDED
@@ -0,0 +1,56 @@
+/*
+ * floyd_warshall.h
+ *
+ * Menores distancias entre todos os pares para grafos densos (matriz de
+ * adjacencia), por Floyd-Warshall em blocos. Para grafos esparsos prefira
+ * calcula_distancias (distancias.h), um Dijkstra por origem.
+ */
+
+#ifndef FLOYD_WARSHALL_H_
+#define FLOYD_WARSHALL_H_
+
+#include "grafo_matriz.h"
+
+/**
+  * @brief  Floyd-Warshall em blocos, vetorizado e paralelo
+  * @param  matriz: grafo com pesos nao negativos
+  * @param  dist: recebe n * n distancias em ordem de linhas
+  *               (INFINITY se inalcancavel)
+  * @param  proximo: recebe n * n indices: proximo[u * n + v] e o vertice
+  *                  seguinte a u no menor caminho ate v (-1 se inalcancavel).
+  *                  Pode ser NULL
+  * @param  num_threads: numero de threads (0: uma por nucleo)
+  *
+  * @retval Nenhum
+  */
+void floyd_warshall_matriz(grafo_matriz_t *matriz, float *dist, int *proximo, int num_threads);
+
+/* Versao sequencial de referencia, sem blocos, O(n^3) escalar. As distancias
+ * coincidem com as de floyd_warshall_matriz apenas a menos de arredondamento,
+ * pois a ordem das somas difere; entre caminhos empatados os proximos podem
+ * diferir */
+void floyd_warshall_simples(grafo_matriz_t *matriz, float *dist, int *proximo);
+
+/* Confere floyd_warshall_matriz com floyd_warshall_simples: distancias a
+ * menos de arredondamento e caminhos sem laco com o custo da distancia.
+ * Retorna 1 se conferiu, 0 (com o par em stderr) se nao */
+int floyd_warshall_confere(grafo_matriz_t *matriz, int num_threads);
+
+/**
+  * @brief  Reconstroi um caminho a partir da matriz de proximos
+  * @param  proximo: matriz de floyd_warshall_matriz
+  * @param  n: numero de vertices
+  * @param  u, v: origem e destino
+  * @param  caminho: recebe os indices de u ate v
+  * @param  max: capacidade de caminho
+  *
+  * Matrizes de floyd_warshall_matriz nunca tem lacos: os proximos ate v
+  * formam uma arvore de menores caminhos. O percurso e limitado a n vertices apenas
+  * para rejeitar matrizes corrompidas.
+  *
+  * @retval int: numero de vertices do caminho, 0 se inalcancavel, -1 se a
+  *              matriz for invalida. Se maior que max, caminho nao e escrito.
+  */
+int floyd_caminho(const int *proximo, int n, int u, int v, int *caminho, int max);
+
+#endif /* FLOYD_WARSHALL_H_ */
@@ -29,15 +29,28 @@ vertice_t* grafo_adicionar_vertice(grafo_t *grafo, int id);
  * adiciona_adjacentes(grafo, vertice, 4, 2, 9, 3, 15);  */
 void adiciona_adjacentes(grafo_t *grafo, vertice_t *vertice, int n, ...);
 
+/* Cria somente a aresta fonte -> destino, sem a contra-aresta */
+void adiciona_arco(grafo_t *grafo, vertice_t *fonte, vertice_t *destino, float peso);
+
+/* Copia uma aresta de outro grafo, criando os vertices que faltarem.
+ * Utilizado para montar a arvore geradora minima */
 void adiciona_aresta_grafo(grafo_t *grafo, arestas_t *aresta);
 
-/* Procura um vertice no grafo com id numerico */
+/* Nomeia o vertice com uma copia do nome, liberada junto com o grafo */
+void grafo_set_nome(grafo_t *grafo, vertice_t *vertice, const char *nome);
+
+/* Procura um vertice no grafo com id numerico: O(1) */
 vertice_t* procura_vertice(grafo_t *grafo, int id);
 
+/* Obtem o vertice pelo indice denso [0, numero_vertices)
+ * Ver: vertice_get_indice */
+vertice_t* grafo_get_vertice(grafo_t *grafo, int indice);
+
 /* Exporta o grafo utilizando a linguagem dot */
 void exportar_grafo_dot(const char *filename, grafo_t *grafo);
 
-/* Libera memoria utilizada pelo grafo */
+/* Libera memoria utilizada pelo grafo: vertices, arestas e nomes copiados
+ * por grafo_set_nome sao liberados em bloco */
 void libera_grafo(grafo_t *grafo);
 
 /* Procura um vertice com menor a menor distancia
@@ -49,7 +62,6 @@ int busca_vertice(lista_enc_t *lista, vertice_t *vertice_procurado);
 
 int numero_vertices(grafo_t *grafo);
 
-/* Retorna a lista de vértices do grafo*/
-lista_enc_t* componentes_conexos(grafo_t *grafo);
+/* Componentes conexos: ver componentes.h */
 
 #endif /* GRAFO_GRAFO_H_ */
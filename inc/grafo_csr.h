@@ -0,0 +1,59 @@
+/*
+ * grafo_csr.h
+ *
+ * Fotografia imutavel de um grafo_t em formato CSR (compressed sparse row).
+ * Os vertices mantem o indice denso do grafo de origem e as arestas de cada
+ * vertice ficam contiguas: vizinhos[offsets[v] .. offsets[v+1]) com os pesos
+ * correspondentes em pesos[]. Indicado para consultas somente leitura.
+ */
+
+#ifndef GRAFO_CSR_H_
+#define GRAFO_CSR_H_
+
+#include "grafo.h"
+
+typedef struct grafos_csr grafo_csr_t;
+
+/* Cria a fotografia do grafo. Alteracoes posteriores no grafo nao sao refletidas */
+grafo_csr_t *cria_grafo_csr(grafo_t *grafo);
+
+/* Cria a fotografia com as arestas invertidas (v -> u para cada u -> v).
+ * Em grafos nao direcionados o resultado tem as mesmas adjacencias */
+grafo_csr_t *cria_grafo_csr_transposto(grafo_csr_t *csr);
+
+/* Grava a fotografia em arquivo binario versionado, little-endian: ids,
+ * offsets, vizinhos, pesos e tabela de nomes */
+void salva_grafo_csr(grafo_csr_t *csr, const char *arquivo);
+
+/* Abre um arquivo de salva_grafo_csr com mmap, sem leitura nem conversao.
+ * O resultado e usado como qualquer outra fotografia */
+grafo_csr_t *carrega_grafo_csr(const char *arquivo);
+
+/* Libera a fotografia */
+void libera_grafo_csr(grafo_csr_t *csr);
+
+int csr_num_vertices(grafo_csr_t *csr);
+int csr_num_arestas(grafo_csr_t *csr);
+
+/* Vetores internos, somente leitura:
+ * offsets: num_vertices + 1 posicoes; vizinhos/pesos: num_arestas posicoes */
+const int *csr_offsets(grafo_csr_t *csr);
+const int *csr_vizinhos(grafo_csr_t *csr);
+const float *csr_pesos(grafo_csr_t *csr);
+
+/* Pesos como inteiros (ex.: read_table_opcoes com TABELA_MINUTOS), paralelo
+ * a vizinhos. NULL se algum peso nao for inteiro nao negativo ou se uma
+ * distancia puder ultrapassar INT_MAX */
+const int *csr_pesos_inteiros(grafo_csr_t *csr);
+
+/* Maior peso inteiro. 0 se csr_pesos_inteiros for NULL */
+int csr_peso_maximo(grafo_csr_t *csr);
+
+/* Identificacao (ex.: codigo IBGE) e nome do vertice de indice denso v */
+int csr_id(grafo_csr_t *csr, int v);
+const char *csr_nome(grafo_csr_t *csr, int v);
+
+/* Indice denso do vertice com identificacao id. -1 se nao existir */
+int csr_indice(grafo_csr_t *csr, int id);
+
+#endif /* GRAFO_CSR_H_ */
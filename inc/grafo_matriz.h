@@ -0,0 +1,43 @@
+/*
+ * grafo_matriz.h
+ *
+ * Grafo nao direcionado representado por matriz de adjacencia densa.
+ * Adequado para tabelas completas de tempos entre cidades, onde E ~ V^2.
+ */
+
+#ifndef GRAFO_MATRIZ_H_
+#define GRAFO_MATRIZ_H_
+
+typedef struct grafos_matriz grafo_matriz_t;
+
+/* Cria uma matriz vazia com espaco para capacidade vertices (cresce se necessario) */
+grafo_matriz_t *cria_grafo_matriz(int capacidade);
+
+/* Adiciona um vertice e retorna seu indice denso. O nome e copiado */
+int matriz_adicionar_vertice(grafo_matriz_t *matriz, int id, const char *nome);
+
+/* Reserva espaco para capacidade vertices */
+void matriz_reserva(grafo_matriz_t *matriz, int capacidade);
+
+/* Altera o nome do vertice v. O nome e copiado */
+void matriz_set_nome(grafo_matriz_t *matriz, int v, const char *nome);
+
+/* Indice denso do vertice com identificacao id. -1 se nao existir */
+int matriz_indice(grafo_matriz_t *matriz, int id);
+
+int matriz_num_vertices(grafo_matriz_t *matriz);
+int matriz_id(grafo_matriz_t *matriz, int v);
+const char *matriz_nome(grafo_matriz_t *matriz, int v);
+
+/* Adiciona a aresta {u, v}. Entre arestas paralelas prevalece a mais leve */
+void matriz_adiciona_aresta(grafo_matriz_t *matriz, int u, int v, float peso);
+
+/* Peso da aresta {u, v}. INFINITY se nao houver aresta */
+float matriz_get_peso(grafo_matriz_t *matriz, int u, int v);
+
+/* Linha u da matriz: matriz_num_vertices pesos contiguos */
+const float *matriz_linha(grafo_matriz_t *matriz, int u);
+
+void libera_grafo_matriz(grafo_matriz_t *matriz);
+
+#endif /* GRAFO_MATRIZ_H_ */
@@ -0,0 +1,83 @@
+/*
+ * hierarquia.h
+ *
+ * Hierarquias de contracao (Geisberger et al.). Os vertices sao contraidos
+ * um a um, do menos ao mais importante; ao remover v, cada caminho u -> v
+ * -> w que nao tenha alternativa igual ou mais curta vira um atalho u -> w.
+ * Toda consulta passa a ser uma busca bidirecional que so sobe na ordem de
+ * contracao, visitando uma fracao minima do grafo. Os atalhos guardam o
+ * vertice contraido, o que permite desempacotar o caminho original.
+ *
+ * Uso:
+ *   h = cria_hierarquia(csr, 0);            // ou carrega_hierarquia
+ *   d = hierarquia_consulta(h, s, t, frente, tras, &encontro);
+ *   tamanho = hierarquia_caminho(h, frente, tras, encontro, caminho, max);
+ */
+
+#ifndef HIERARQUIA_H_
+#define HIERARQUIA_H_
+
+#include "grafo_csr.h"
+#include "espaco_busca.h"
+
+typedef struct hierarquia hierarquia_t;
+
+/**
+  * @brief  Contrai o grafo e monta a hierarquia
+  * @param  csr: grafo com pesos nao negativos, dirigido ou nao
+  * @param  num_threads: numero de threads (0: uma por nucleo)
+  *
+  * A importancia de um vertice e a diferenca de arestas (atalhos criados
+  * menos arestas removidas) mais o numero de vizinhos ja contraidos. A cada
+  * rodada, os vertices menos importantes que todos os seus vizinhos formam
+  * um conjunto independente; as buscas de testemunhas desse conjunto e a
+  * atualizacao das importancias correm em paralelo.
+  *
+  * @retval hierarquia_t: hierarquia em memoria, independente do csr
+  */
+hierarquia_t *cria_hierarquia(grafo_csr_t *csr, int num_threads);
+
+/* Grava a hierarquia e os ids dos vertices em arquivo binario */
+void salva_hierarquia(hierarquia_t *hierarquia, const char *arquivo);
+
+/* Abre um arquivo de salva_hierarquia com mmap, somente leitura. Os ids
+ * devem coincidir com os do csr */
+hierarquia_t *carrega_hierarquia(const char *arquivo, grafo_csr_t *csr);
+
+int hierarquia_num_vertices(hierarquia_t *hierarquia);
+
+/* Numero de arestas da hierarquia, atalhos inclusos */
+int hierarquia_num_arestas(hierarquia_t *hierarquia);
+
+/* Posicao de v na ordem de contracao: 0 e o primeiro contraido */
+int hierarquia_nivel(hierarquia_t *hierarquia, int v);
+
+/**
+  * @brief  Menor distancia por busca bidirecional ascendente
+  * @param  hierarquia: hierarquia do grafo
+  * @param  fonte, destino: indices dos extremos
+  * @param  frente, tras: espacos distintos para as duas buscas
+  * @param  encontro: recebe o vertice mais alto do caminho (-1 se
+  *                   inalcancavel)
+  *
+  * @retval float: distancia de fonte a destino (INFINITY se inalcancavel)
+  */
+float hierarquia_consulta(hierarquia_t *hierarquia, int fonte, int destino,
+                          espaco_busca_t *frente, espaco_busca_t *tras, int *encontro);
+
+/**
+  * @brief  Caminho no grafo original, com os atalhos desempacotados
+  * @param  hierarquia: hierarquia da consulta
+  * @param  frente, tras, encontro: estado de hierarquia_consulta
+  * @param  caminho: recebe os indices da fonte ate destino
+  * @param  max: capacidade de caminho
+  *
+  * @retval int: numero de vertices do caminho, 0 se inalcancavel.
+  *              Se maior que max, caminho nao e escrito.
+  */
+int hierarquia_caminho(hierarquia_t *hierarquia, espaco_busca_t *frente,
+                       espaco_busca_t *tras, int encontro, int *caminho, int max);
+
+void libera_hierarquia(hierarquia_t *hierarquia);
+
+#endif /* HIERARQUIA_H_ */
@@ -0,0 +1,48 @@
+#ifndef LEITOR_TABELA_H_INCLUDED
+#define LEITOR_TABELA_H_INCLUDED
+
+/* Leitor da tabela de tempos entre cidades (ex.: tempo.csv):
+ *
+ *   linha 1: <rotulo>,,<id coluna 0>,<id coluna 1>,...
+ *   linha 2: ,<rotulo>,<nome coluna 0>,<nome coluna 1>,...
+ *   demais:  <id>,<nome>,<tempo coluna 0>,<tempo coluna 1>,...
+ *
+ * Tempos no formato HH.MM; -1 ou celula vazia indicam ausencia de ligacao.
+ * O numero de colunas e livre. O arquivo e lido uma unica vez. */
+
+/* Unidade dos tempos entregues a celula */
+typedef enum unidade_tempo
+{
+    TEMPO_DECIMAL,      /*!< "06.21" vira 6.21 */
+    TEMPO_MINUTOS       /*!< "06.21" vira 381 minutos, valor inteiro exato */
+} unidade_tempo_t;
+
+/* Destino dos dados lidos. Permite preencher diferentes representacoes de
+ * grafo com o mesmo leitor */
+typedef struct leitor_tabela
+{
+    void *destino;
+    /* Chamado uma vez antes dos demais: estimativa do numero de cidades
+     * (linhas) e numero exato de colunas */
+    void (*inicio)(void *destino, int linhas, int colunas);
+    /* Chamado para cada cidade de coluna, antes de qualquer linha */
+    void (*coluna)(void *destino, int j, int id);
+    /* Chamado para cada cidade (linha). A cidade pode ja ter sido informada
+     * como coluna */
+    void (*vertice)(void *destino, int id, const char *nome);
+    /* Chamado para cada celula valida da ultima linha informada */
+    void (*celula)(void *destino, int id_linha, int j, float tempo);
+    unidade_tempo_t unidade;
+} leitor_tabela_t;
+
+/* Le o arquivo e repassa o conteudo ao leitor. Encerra o programa em erro */
+void le_tabela(const char *arquivo, leitor_tabela_t *leitor);
+
+/* Converte um tempo "HH.MM" de tamanho n. Retorna -1 se vazio ou "-1" */
+float converte_tempo(const char *texto, int n);
+
+/* Converte um tempo "HH.MM" de tamanho n em minutos: HH * 60 + MM.
+ * Retorna -1 se vazio, "-1" ou com mais de 59 minutos */
+int converte_minutos(const char *texto, int n);
+
+#endif // LEITOR_TABELA_H_INCLUDED
@@ -6,6 +6,9 @@
 typedef struct listas_enc lista_enc_t;
 
 lista_enc_t *cria_lista_enc(void);
+
+/* Cria a lista na arena: liberada junto com a arena */
+lista_enc_t *cria_lista_enc_arena(arena_t *arena);
 void add_cauda(lista_enc_t *lista, no_t* elemento);
 no_t *obter_cabeca(lista_enc_t *lista);
 int lista_vazia(lista_enc_t *lista);
@@ -0,0 +1,71 @@
+/*
+ * motor.h
+ *
+ * Motor de consultas concorrentes. O grafo e carregado uma vez e congelado
+ * em uma fotografia CSR compartilhada, somente leitura; um conjunto fixo de
+ * threads atende as consultas, cada uma com o seu espaco de busca.
+ *
+ * Uso:
+ *   motor = cria_motor(grafo, 0);
+ *   motor_submeter(motor, &c1); motor_submeter(motor, &c2); ...
+ *   motor_aguardar(motor);      // c1, c2, ... com resultados preenchidos
+ *   libera_motor(motor);
+ */
+
+#ifndef MOTOR_H_
+#define MOTOR_H_
+
+#include "grafo.h"
+#include "grafo_csr.h"
+
+typedef struct motores motor_t;
+
+typedef enum tipo_consulta
+{
+    CONSULTA_DIJKSTRA,  /*!< Menor caminho de fonte a destino */
+    CONSULTA_BFS,       /*!< Busca em largura a partir de fonte */
+    CONSULTA_PRIM       /*!< Arvore geradora minima com raiz em fonte */
+} tipo_consulta_t;
+
+/* Consulta e resultado. A memoria pertence ao chamador e deve permanecer
+ * valida ate motor_aguardar retornar. Vertices sao indices do CSR
+ * (ver csr_indice). */
+typedef struct consulta
+{
+    /* Entrada */
+    tipo_consulta_t tipo;
+    int fonte;
+    int destino;        /*!< Dijkstra e BFS; -1 para todos os vertices */
+    int *caminho;       /*!< Opcional: recebe o caminho fonte..destino */
+    int max_caminho;    /*!< Capacidade de caminho */
+    int *pai;           /*!< Opcional: recebe o pai de todos os vertices */
+
+    /* Saida */
+    float custo;        /*!< Distancia (Dijkstra), saltos (BFS) ou peso total (Prim) */
+    int alcancados;     /*!< Vertices alcancados (BFS e Prim) */
+    int tamanho_caminho;/*!< Vertices do caminho, 0 se inalcancavel */
+} consulta_t;
+
+/* Congela o grafo e inicia num_trabalhadores threads (0: uma por nucleo).
+ * Alteracoes posteriores no grafo nao sao vistas pelo motor. */
+motor_t *cria_motor(grafo_t *grafo, int num_trabalhadores);
+
+/* Mesmo que cria_motor sobre uma fotografia pronta (ex.: carrega_grafo_csr),
+ * sem passar por grafo_t. O motor passa a ser dono do csr */
+motor_t *cria_motor_csr(grafo_csr_t *csr, int num_trabalhadores);
+
+/* Enfileira a consulta. Nao bloqueia */
+void motor_submeter(motor_t *motor, consulta_t *consulta);
+
+/* Bloqueia ate todas as consultas submetidas terem sido respondidas */
+void motor_aguardar(motor_t *motor);
+
+int motor_num_trabalhadores(motor_t *motor);
+
+/* Fotografia usada pelo motor, para traduzir ids e nomes */
+grafo_csr_t *motor_csr(motor_t *motor);
+
+/* Aguarda as consultas pendentes, encerra as threads e libera o motor */
+void libera_motor(motor_t *motor);
+
+#endif /* MOTOR_H_ */
@@ -1,10 +1,18 @@
 #ifndef NO_H_INCLUDED
 #define NO_H_INCLUDED
 
+#include "arena.h"
+
 typedef struct nos no_t;
 
 no_t *cria_no(void *dado);
 
+/* Cria um no a partir de um pool (ver arena.h). Nao deve ser liberado com free */
+no_t *cria_no_pool(pool_t *pool, void *dado);
+
+/* Tamanho de no_t, para criacao de pools */
+size_t tamanho_no(void);
+
 void liga_nos (no_t *fonte, no_t *destino);
 void desliga_no (no_t *no);
 
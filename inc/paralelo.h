@@ -0,0 +1,23 @@
+#ifndef PARALELO_H_INCLUDED
+#define PARALELO_H_INCLUDED
+
+#include <stddef.h>
+
+/* Paralelismo de bifurcacao e juncao (fork-join) para os algoritmos em
+ * lote. Diferente de motor.h, as threads vivem apenas durante a chamada. */
+
+/* Numero de threads padrao: um por nucleo disponivel */
+int paralelo_num_threads(void);
+
+/* Executa tarefa(contexto, i) para cada i em [0, num_tarefas) usando ate
+ * num_threads threads (0: paralelo_num_threads). A thread chamadora
+ * participa. Retorna apos todas as tarefas terminarem. */
+void paralelo_executa(int num_threads, int num_tarefas,
+                      void (*tarefa)(void *contexto, int i), void *contexto);
+
+/* Ordenacao com a mesma interface de qsort: blocos ordenados em paralelo e
+ * intercalados em rodadas, tambem em paralelo. Nao e estavel. */
+void paralelo_ordena(void *base, size_t n, size_t tamanho,
+                     int (*compara)(const void *, const void *), int num_threads);
+
+#endif // PARALELO_H_INCLUDED
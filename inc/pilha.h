@@ -1,15 +1,20 @@
 #ifndef PILHA_H_INCLUDED
 #define PILHA_H_INCLUDED
 
-
+/* Pilha generica em vetor contiguo que dobra de tamanho quando cheio;
+ * push/pop nao alocam memoria enquanto houver espaco */
 typedef struct pilhas pilha_t;
 
 pilha_t * cria_pilha (void);
 
+/* Cria a pilha ja com espaco para capacidade dados */
+pilha_t * cria_pilha_tamanho (int capacidade);
+
 void push(void *dado, pilha_t *pilha);
 void* pop(pilha_t *pilha);
 
 int pilha_vazia(pilha_t *pilha);
+int pilha_tamanho(pilha_t *pilha);
 void libera_pilha(pilha_t *pilha);
 
 #endif // PILHA_H_INCLUDED
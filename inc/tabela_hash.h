@@ -0,0 +1,25 @@
+#ifndef TABELA_HASH_H_INCLUDED
+#define TABELA_HASH_H_INCLUDED
+
+/* Tabela hash de enderecamento aberto (sondagem linear) que mapeia chaves
+ * inteiras esparsas (ex.: codigo IBGE) em valores inteiros nao negativos
+ * (ex.: indice denso do vertice) */
+typedef struct tabelas_hash tabela_hash_t;
+
+/* Valor retornado quando a chave nao existe */
+#define HASH_AUSENTE -1
+
+/* Cria uma tabela dimensionada para ao menos capacidade chaves */
+tabela_hash_t *cria_tabela_hash(int capacidade);
+
+/* Insere ou substitui o valor (>= 0) associado a chave */
+void tabela_hash_inserir(tabela_hash_t *tabela, int chave, int valor);
+
+/* Retorna o valor associado a chave ou HASH_AUSENTE */
+int tabela_hash_buscar(tabela_hash_t *tabela, int chave);
+
+int tabela_hash_tamanho(tabela_hash_t *tabela);
+
+void libera_tabela_hash(tabela_hash_t *tabela);
+
+#endif // TABELA_HASH_H_INCLUDED
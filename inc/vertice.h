@@ -20,12 +20,25 @@ typedef enum status_aresta { VAZIO, EXPORTADA } status_aresta_t;
 /* Cria um novo vertice com id */
 vertice_t *cria_vertice(int id);
 
+/* Cria um vertice na arena. Os nos da lista de arestas vem de pool_nos */
+vertice_t *cria_vertice_arena(arena_t *arena, pool_t *pool_nos, int id);
+
 /* Cria uma nova aresta */
 arestas_t *cria_aresta(vertice_t *fonte, vertice_t *destino, float peso);
 
+/* Cria uma aresta a partir de um pool de objetos de tamanho_aresta() bytes */
+arestas_t *cria_aresta_pool(pool_t *pool, vertice_t *fonte, vertice_t *destino, float peso);
+
+size_t tamanho_aresta(void);
+
 /* Obtem id de um vertice */
 int vertice_get_id(vertice_t *vertice);
 
+/* Indice denso do vertice no grafo: [0, numero_vertices).
+ * Configurado por grafo_adicionar_vertice */
+void vertice_set_indice(vertice_t *vertice, int indice);
+int vertice_get_indice(vertice_t *vertice);
+
 /* Nomeia o vertice */
 void vertice_set_nome(vertice_t *vertice, char *nome);
 
@@ -86,7 +99,7 @@ float vertice_get_dist(vertice_t *vertice);
  * Configurado por Dijkstra  */
 vertice_t *vertice_get_antec_caminho(vertice_t *vertice);
 
-/* Configura vertice antessor do menor caminho */
+/* Configura vertice antessor do menor caminho. NULL se nao houver */
 void vertice_set_antec_caminho(vertice_t *vertice, vertice_t *antecessor);
 
 /* Retorna o comprimento de dois vertices adjacentes */
@@ -2,132 +2,177 @@
 #include <stdlib.h>
 #include <limits.h>
 #include <string.h>
+#include <math.h>
 
 #include "fila.h"
+#include "fila_prioridade.h"
+#include "leitor_tabela.h"
+#include "grafo_csr.h"
+#include "algoritmos_csr.h"
+#include "delta_stepping.h"
+#include "arvore_geradora.h"
 #include "algoritimos.h"
 
-#define N 1000
-#define M 22
-
 #define FALSE 0
 #define TRUE 1
-#define INFINIT -1
 
-typedef struct priority_queue
+/* Preenchimento de grafo_t (listas encadeadas) */
+typedef struct destino_grafo
 {
-  int queue_size;
-  int queue_index;
-  arestas_t **pri_queue;
-} priority_queue_t;
+    grafo_t *grafo;
+    vertice_t **colunas;    /*!< Vertices das colunas, resolvidos uma unica vez */
+} destino_grafo_t;
 
-void read_table(grafo_t *grafo, char *table)
+/* Vertice com identificacao id, criado se ainda nao existir */
+static vertice_t *obtem_vertice(grafo_t *grafo, int id)
 {
-    char buffer[N], temp_char[100], **city;
-    int i, j, linha = 0, cod[M], *id, temp_int;
-    float time[M];
-    vertice_t *vertices;
-    FILE *fp;
+    vertice_t *vertice = procura_vertice(grafo, id);
 
-    fp = fopen(table, "r");
+    return vertice ? vertice : grafo_adicionar_vertice(grafo, id);
+}
 
-    if(!fp)
-    {
-        perror("Erro ao ler tabela");
-        exit(EXIT_FAILURE);
-    }
+static void grafo_inicio(void *destino, int linhas, int colunas)
+{
+    destino_grafo_t *d = destino;
 
-    while(fgets(buffer, N, fp) != NULL)
-        linha++;
+    (void) linhas;
 
-    city = malloc((linha-2)*sizeof(char*));
-    if(city == NULL)
+    d->colunas = malloc(colunas * sizeof(vertice_t*));
+    if (d->colunas == NULL)
     {
-        perror("Erro ao alocar cidades");
-        fclose(fp);
+        perror("Erro ao alocar colunas");
         exit(EXIT_FAILURE);
     }
+}
+
+static void grafo_coluna(void *destino, int j, int id)
+{
+    destino_grafo_t *d = destino;
 
-    id = malloc((linha-2)*sizeof(int));
-    if(id == NULL)
+    d->colunas[j] = obtem_vertice(d->grafo, id);
+}
+
+static void grafo_vertice(void *destino, int id, const char *nome)
+{
+    destino_grafo_t *d = destino;
+    vertice_t *vertice;
+
+    vertice = obtem_vertice(d->grafo, id);
+    if (vertice_get_nome(vertice) != NULL)
     {
-        perror("Erro ao alocar ids das cidades");
-        fclose(fp);
+        fprintf(stderr, "read_table: cidade %d duplicada\n", id);
         exit(EXIT_FAILURE);
     }
 
-    rewind(fp);
+    grafo_set_nome(d->grafo, vertice, nome);
+}
 
-    fgets(buffer, N, fp); // Ignorando primeira e segunda linha
-    fgets(buffer, N, fp);
+static void grafo_celula(void *destino, int id_linha, int j, float tempo)
+{
+    destino_grafo_t *d = destino;
 
-    for (i = 0; i < linha - 2; ++i)
-    {
-        fgets(buffer, N, fp);
+    adiciona_adjacentes(d->grafo, d->colunas[j], 2, id_linha, tempo);
+}
 
-        sscanf(buffer, "%d,%50[^,],", &id[i], temp_char);
+/* Tabela assimetrica: a celula (linha, coluna) e o tempo da cidade da
+ * linha ate a da coluna */
+static void grafo_celula_arco(void *destino, int id_linha, int j, float tempo)
+{
+    destino_grafo_t *d = destino;
 
-        city[i] = malloc((strlen(temp_char)+1)*sizeof(char));
-        if(!city[i])
-        {
-          perror("Erro ao alocar memória para o nome da cidade");
-          fclose(fp);
-          exit(EXIT_FAILURE);
-        }
-        strcpy(city[i], temp_char);
+    adiciona_arco(d->grafo, procura_vertice(d->grafo, id_linha), d->colunas[j], tempo);
+}
 
-        #ifdef DEBUG
-                printf("%d - %s\n", id[i], city[i]);
-        #endif
+void read_table_opcoes(grafo_t *grafo, char *table, int opcoes)
+{
+    destino_grafo_t destino = { grafo, NULL };
+    leitor_tabela_t leitor = { &destino, grafo_inicio, grafo_coluna, grafo_vertice,
+                               (opcoes & TABELA_DIRECIONADA) ? grafo_celula_arco : grafo_celula,
+                               (opcoes & TABELA_MINUTOS) ? TEMPO_MINUTOS : TEMPO_DECIMAL };
 
-        vertices = grafo_adicionar_vertice(grafo, id[i]);
-        vertice_set_nome(vertices, city[i]);
-    }
-    rewind(fp);
+    le_tabela(table, &leitor);
 
-    // Pegando as cidades das colunas
-    fgets(buffer, N, fp);
-    int ret = sscanf(buffer, "%50[^,],,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,\
-    %d,%d,%d,%d,%d,%d,%d,%d,",
-    temp_char, &cod[0], &cod[1], &cod[2], &cod[3], &cod[4], &cod[5], &cod[6], &cod[7],
-    &cod[8], &cod[9], &cod[10], &cod[11], &cod[12], &cod[13], &cod[14], &cod[15],
-    &cod[16], &cod[17], &cod[18], &cod[19], &cod[20], &cod[21], &cod[22]);
+    free(destino.colunas);
+}
 
-    if (ret != 24)
+void read_table(grafo_t *grafo, char *table)
+{
+    read_table_opcoes(grafo, table, 0);
+}
+
+void read_table_direcionado(grafo_t *grafo, char *table)
+{
+    read_table_opcoes(grafo, table, TABELA_DIRECIONADA);
+}
+
+/* Preenchimento de grafo_matriz_t (matriz de adjacencia) */
+typedef struct destino_matriz
+{
+    grafo_matriz_t *matriz;
+    int *colunas;           /*!< Indice na matriz de cada coluna da tabela */
+    int linha;              /*!< Indice da cidade da linha atual */
+} destino_matriz_t;
+
+static int obtem_indice(grafo_matriz_t *matriz, int id)
+{
+    int v = matriz_indice(matriz, id);
+
+    return v >= 0 ? v : matriz_adicionar_vertice(matriz, id, NULL);
+}
+
+static void matriz_inicio(void *destino, int linhas, int colunas)
+{
+    destino_matriz_t *d = destino;
+
+    matriz_reserva(d->matriz, linhas);
+
+    d->colunas = malloc(colunas * sizeof(int));
+    if (d->colunas == NULL)
     {
-        fprintf(stderr, "Erro processando cidade %s - linha: %d.\n", __FILE__, __LINE__);
-        exit(-1);
+        perror("Erro ao alocar colunas");
+        exit(EXIT_FAILURE);
     }
-    // Ignorando a segunda linha
-    fgets(buffer, N, fp);
+}
 
-    for(i = 2; i < linha; i++)
-    {
-        fgets(buffer, N, fp);
-        int ret = sscanf(buffer, "%d,%50[^,],%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,\
-        %f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,", &temp_int, temp_char, &time[0], &time[1],
-        &time[2], &time[3], &time[4], &time[5], &time[6], &time[7], &time[8],
-        &time[9], &time[10], &time[11], &time[12], &time[13], &time[14], &time[15],
-        &time[16], &time[17], &time[18], &time[19], &time[20], &time[21], &time[22]);
-
-        if (ret != 25)
-        {
-            fprintf(stderr, "Erro processado cidade %s - linha: %d.\n", __FILE__, __LINE__);
-            exit(-1);
-        }
+static void matriz_coluna(void *destino, int j, int id)
+{
+    destino_matriz_t *d = destino;
 
-        for(j = 0; j < M; ++j)
-        {
-          vertices = procura_vertice(grafo, cod[j]);
+    d->colunas[j] = obtem_indice(d->matriz, id);
+}
 
-          if(time[j]!=INFINIT)
-          {
-              adiciona_adjacentes(grafo, vertices, 2, id[i-2], time[j]);
-          }
-        }
+static void matriz_vertice(void *destino, int id, const char *nome)
+{
+    destino_matriz_t *d = destino;
+
+    d->linha = obtem_indice(d->matriz, id);
+    if (matriz_nome(d->matriz, d->linha) != NULL)
+    {
+        fprintf(stderr, "read_table_matriz: cidade %d duplicada\n", id);
+        exit(EXIT_FAILURE);
     }
-    free(id);
-    free(city);
-    fclose(fp);
+
+    matriz_set_nome(d->matriz, d->linha, nome);
+}
+
+static void matriz_celula(void *destino, int id_linha, int j, float tempo)
+{
+    destino_matriz_t *d = destino;
+
+    (void) id_linha;
+
+    matriz_adiciona_aresta(d->matriz, d->linha, d->colunas[j], tempo);
+}
+
+void read_table_matriz(grafo_matriz_t *matriz, char *table)
+{
+    destino_matriz_t destino = { matriz, NULL, -1 };
+    leitor_tabela_t leitor = { &destino, matriz_inicio, matriz_coluna,
+                               matriz_vertice, matriz_celula, TEMPO_DECIMAL };
+
+    le_tabela(table, &leitor);
+
+    free(destino.colunas);
 }
 
 vertice_t *buscar_vertice(lista_enc_t *lista, int id)
@@ -147,172 +192,639 @@ vertice_t *buscar_vertice(lista_enc_t *lista, int id)
     return 0;
 }
 
+/* Copia o resultado de uma consulta para os campos dos vertices, mantendo o
+ * comportamento das funcoes sem espaco de busca. dist_ausente e o valor de
+ * dist dos vertices nao alcancados */
+static void copia_para_vertices(grafo_t *grafo, espaco_busca_t *espaco, float dist_ausente)
+{
+    int i, n = numero_vertices(grafo), pai;
+    vertice_t *v;
+    float dist;
+
+    for (i = 0; i < n; i++)
+    {
+        v = grafo_get_vertice(grafo, i);
+        dist = espaco_get_dist(espaco, i);
+        pai = espaco_get_pai(espaco, i);
+
+        vertice_set_dist(v, dist == INFINITY ? dist_ausente : dist);
+        vertice_set_pai(v, pai >= 0 ? grafo_get_vertice(grafo, pai) : NULL);
+        vertice_set_antec_caminho(v, pai >= 0 ? grafo_get_vertice(grafo, pai) : NULL);
+        vertice_visitado(v, espaco_visitado(espaco, i));
+    }
+}
+
 /**
-  * @brief  Busca em profundidade
-  * @param	grafo: ponteiro do grafo que se deseja executar a busca
-  * @param  inicial: ponteiro do vértice inicial (fonte) da busca
+  * @brief  Dijkstra com parada antecipada, sem alterar o grafo
+  * @param	grafo: grafo com pesos não negativos
+  * @param  fonte: vértice de origem
+  * @param  destino: vértice de destino. NULL calcula todas as distâncias
+  * @param  espaco: estado da consulta (reiniciado por esta função)
   *
-  * @retval Nenhum: Vértices são marcados internamente
+  * Distância, antecessor e aresta de cada vértice ficam no espaço de busca.
+  * A busca termina assim que o destino é retirado da fila, pois sua
+  * distância já é definitiva.
+  *
+  * @retval int: TRUE se o destino foi alcançado
   */
-void dfs(grafo_t *grafo, vertice_t* inicial)
+int dijkstra_espaco(grafo_t *grafo, vertice_t *fonte, vertice_t *destino,
+                    espaco_busca_t *espaco)
 {
+    int alvo, u, w;
+    float d, nova;
     no_t *no;
-    pilha_t* pilha;
     arestas_t *aresta;
-    vertice_t *u, *v;
-    lista_enc_t * lista_aresta;
-
-    pilha = cria_pilha();
-
-    no = obter_cabeca(componentes_conexos(grafo));
+    fila_prioridade_t *fila;
 
-    while(no)
+    if (grafo == NULL || fonte == NULL || espaco == NULL)
     {
-        v = obter_dado(no);
-        vertice_visitado(v, FALSE);
-        no = obtem_proximo(no);
+        fprintf(stderr, "Dijkstra: parametros invalidos\n");
+        exit(EXIT_FAILURE);
     }
 
-    push(inicial, pilha);
+    espaco_reinicia(espaco);
+    fila = espaco_fila_prioridade(espaco);
+    alvo = destino ? vertice_get_indice(destino) : -1;
 
-    while(!pilha_vazia(pilha))
+    espaco_set_dist(espaco, vertice_get_indice(fonte), 0);
+    fila_prioridade_inserir(fila, vertice_get_indice(fonte), 0);
+
+    while (!fila_prioridade_vazia(fila))
     {
-        u = pop(pilha);
-        lista_aresta = vertice_get_arestas(u);
-        no = obter_cabeca(lista_aresta);
+        u = fila_prioridade_remover_min(fila, &d);
+        espaco_visita(espaco, u);
+        if (u == alvo)
+            break;
 
-        while(no)
+        no = obter_cabeca(vertice_get_arestas(grafo_get_vertice(grafo, u)));
+        while (no)
         {
             aresta = obter_dado(no);
-            v = aresta_get_adjacente(aresta);
-            if(!vertice_get_visit(v))
+            w = vertice_get_indice(aresta_get_adjacente(aresta));
+            nova = d + aresta_get_peso(aresta);
+
+            if (nova < espaco_get_dist(espaco, w))
             {
-                vertice_visitado(v,TRUE);
-                push(v, pilha);
+                espaco_set_dist(espaco, w, nova);
+                espaco_set_pai(espaco, w, u);
+                espaco_set_aresta(espaco, w, aresta);
+                fila_prioridade_atualizar(fila, w, nova);
             }
+            no = obtem_proximo(no);
         }
     }
+
+    return alvo == -1 || espaco_get_dist(espaco, alvo) != INFINITY;
 }
 
 /**
-  * @brief  Busca em largura
+  * @brief  Reconstrói o caminho encontrado por dijkstra_espaco
+  * @param	grafo: grafo da consulta
+  * @param  espaco: estado da consulta
+  * @param  destino: vértice final do caminho
+  * @param  caminho: vetor fornecido pelo chamador
+  * @param  max: capacidade de caminho
+  *
+  * @retval int: número de vértices do caminho (fonte e destino inclusos).
+  *              0 se inalcançável. Se maior que max, caminho não é escrito.
+  */
+int caminho_espaco(grafo_t *grafo, espaco_busca_t *espaco, vertice_t *destino,
+                   vertice_t **caminho, int max)
+{
+    int tamanho = 0, i, v;
+
+    if (destino == NULL)
+    {
+        fprintf(stderr, "caminho_espaco: destino invalido\n");
+        exit(EXIT_FAILURE);
+    }
+
+    if (espaco_get_dist(espaco, vertice_get_indice(destino)) == INFINITY)
+        return 0;
+
+    for (v = vertice_get_indice(destino); v >= 0; v = espaco_get_pai(espaco, v))
+        tamanho++;
+
+    if (tamanho > max || caminho == NULL)
+        return tamanho;
+
+    i = tamanho - 1;
+    for (v = vertice_get_indice(destino); v >= 0; v = espaco_get_pai(espaco, v))
+        caminho[i--] = grafo_get_vertice(grafo, v);
+
+    return tamanho;
+}
+
+/**
+  * @brief  Menor caminho entre fonte e destino em um vetor contíguo
+  * @param	grafo: grafo com pesos não negativos
+  * @param  fonte: vértice de origem
+  * @param  destino: vértice de destino
+  * @param  caminho: vetor fornecido pelo chamador
+  * @param  max: capacidade de caminho
+  *
+  * Configura dist e antecessor_caminho dos vértices. Para consultas
+  * concorrentes use dijkstra_espaco e caminho_espaco.
+  *
+  * @retval int: número de vértices do caminho (fonte e destino inclusos).
+  *              0 se inalcançável. Se maior que max, caminho não é escrito.
+  */
+int dijkstra_caminho(grafo_t *grafo, vertice_t *fonte, vertice_t *destino,
+                     vertice_t **caminho, int max)
+{
+    espaco_busca_t *espaco;
+    int tamanho;
+
+    if (grafo == NULL || destino == NULL)
+    {
+        fprintf(stderr, "dijkstra_caminho: parametros invalidos\n");
+        exit(EXIT_FAILURE);
+    }
+
+    espaco = cria_espaco_busca(numero_vertices(grafo), HEAP_DARIO);
+
+    dijkstra_espaco(grafo, fonte, destino, espaco);
+    copia_para_vertices(grafo, espaco, INFINITY);
+    tamanho = caminho_espaco(grafo, espaco, destino, caminho, max);
+
+    libera_espaco_busca(espaco);
+
+    return tamanho;
+}
+
+/**
+  * @brief  Menor caminho entre fonte e destino (Dijkstra)
+  * @param	grafo: grafo com pesos não negativos
+  * @param  fonte: vértice de origem
+  * @param  destino: vértice de destino
+  *
+  * @retval pilha_t: pilha com o caminho, fonte no topo. NULL se inalcançável
+  */
+pilha_t* Dijkstra(grafo_t *grafo, vertice_t *fonte, vertice_t *destino)
+{
+    pilha_t *pilha;
+    vertice_t *v;
+    int tamanho;
+
+    tamanho = dijkstra_caminho(grafo, fonte, destino, NULL, 0);
+    if (tamanho == 0)
+        return NULL;
+
+    pilha = cria_pilha_tamanho(tamanho);
+    for (v = destino; v; v = vertice_get_antec_caminho(v))
+        push(v, pilha);
+
+    return pilha;
+}
+
+/**
+  * @brief  Menor caminho entre fonte e destino (Dijkstra bidirecional)
+  * @param	grafo: grafo com pesos não negativos, dirigido ou não
+  * @param  fonte: vértice de origem
+  * @param  destino: vértice de destino
+  *
+  * A busca reversa percorre a fotografia transposta, de modo que tempos
+  * assimétricos (read_table_direcionado) são respeitados. Os vértices do
+  * grafo não são alterados. Para muitas consultas sobre o mesmo grafo use
+  * dijkstra_csr_bidirecional com fotografias e espaços reaproveitados.
+  *
+  * @retval pilha_t: pilha com o caminho, fonte no topo. NULL se inalcançável
+  */
+pilha_t* dijkstra_bidirecional(grafo_t *grafo, vertice_t *fonte, vertice_t *destino)
+{
+    grafo_csr_t *csr, *transposto;
+    espaco_busca_t *frente, *tras;
+    pilha_t *pilha = NULL;
+    int *caminho, tamanho, encontro, n, i;
+
+    if (grafo == NULL || fonte == NULL || destino == NULL)
+    {
+        fprintf(stderr, "dijkstra_bidirecional: parametros invalidos\n");
+        exit(EXIT_FAILURE);
+    }
+
+    n = numero_vertices(grafo);
+    csr = cria_grafo_csr(grafo);
+    transposto = cria_grafo_csr_transposto(csr);
+    frente = cria_espaco_busca(n, HEAP_DARIO);
+    tras = cria_espaco_busca(n, HEAP_DARIO);
+
+    dijkstra_csr_bidirecional(csr, transposto, vertice_get_indice(fonte),
+                              vertice_get_indice(destino), frente, tras, &encontro);
+
+    tamanho = caminho_csr_bidirecional(frente, tras, encontro, NULL, 0);
+    if (tamanho > 0)
+    {
+        caminho = malloc(tamanho * sizeof(int));
+        if (caminho == NULL)
+        {
+            perror("dijkstra_bidirecional:");
+            exit(EXIT_FAILURE);
+        }
+
+        caminho_csr_bidirecional(frente, tras, encontro, caminho, tamanho);
+
+        pilha = cria_pilha_tamanho(tamanho);
+        for (i = tamanho - 1; i >= 0; i--)
+            push(grafo_get_vertice(grafo, caminho[i]), pilha);
+
+        free(caminho);
+    }
+
+    libera_espaco_busca(frente);
+    libera_espaco_busca(tras);
+    libera_grafo_csr(transposto);
+    libera_grafo_csr(csr);
+
+    return pilha;
+}
+
+/**
+  * @brief  Distâncias de fonte a todos os vértices (delta-stepping paralelo)
+  * @param	grafo: grafo com pesos não negativos, dirigido ou não
+  * @param  fonte: vértice de origem
+  * @param  num_threads: número de threads (0: uma por núcleo)
+  *
+  * Preenche dist, pai, antecessor e visitado de cada vértice como Dijkstra
+  * com todos os destinos: dist INFINITY e pai NULL nos inalcançáveis. O
+  * delta é escolhido por delta_stepping_delta.
+  *
+  * @retval Nenhum
+  */
+void delta_stepping(grafo_t *grafo, vertice_t *fonte, int num_threads)
+{
+    grafo_csr_t *csr;
+    vertice_t *v, *pai;
+    float *dist;
+    int *pais, i, n;
+
+    if (grafo == NULL || fonte == NULL)
+    {
+        fprintf(stderr, "delta_stepping: parametros invalidos\n");
+        exit(EXIT_FAILURE);
+    }
+
+    n = numero_vertices(grafo);
+    csr = cria_grafo_csr(grafo);
+    dist = malloc(n * sizeof(float));
+    pais = malloc(n * sizeof(int));
+    if (dist == NULL || pais == NULL)
+    {
+        perror("delta_stepping:");
+        exit(EXIT_FAILURE);
+    }
+
+    delta_stepping_csr(csr, vertice_get_indice(fonte), delta_stepping_delta(csr),
+                       num_threads, dist, pais);
+
+    for (i = 0; i < n; i++)
+    {
+        v = grafo_get_vertice(grafo, i);
+        pai = pais[i] >= 0 ? grafo_get_vertice(grafo, pais[i]) : NULL;
+
+        vertice_set_dist(v, dist[i]);
+        vertice_set_pai(v, pai);
+        vertice_set_antec_caminho(v, pai);
+        vertice_visitado(v, dist[i] != INFINITY);
+    }
+
+    free(dist);
+    free(pais);
+    libera_grafo_csr(csr);
+}
+
+/**
+  * @brief  Busca em profundidade, sem alterar o grafo
+  * @param	grafo: ponteiro do grafo que se deseja executar a busca
+  * @param  inicial: ponteiro do vértice inicial (fonte) da busca
+  * @param  espaco: estado da consulta (reiniciado por esta função)
+  *
+  * Cada vértice da pilha guarda um cursor para a próxima aresta a examinar.
+  *
+  * @retval int: número de vértices visitados
+  */
+int dfs_espaco(grafo_t *grafo, vertice_t* inicial, espaco_busca_t *espaco)
+{
+    int *pilha, topo = 0, visitados = 1, u, w;
+    no_t **cursor;
+
+    if (grafo == NULL || inicial == NULL || espaco == NULL)
+    {
+        fprintf(stderr, "dfs: parametros invalidos\n");
+        exit(EXIT_FAILURE);
+    }
+
+    espaco_reinicia(espaco);
+    pilha = espaco_vetor(espaco);
+    cursor = espaco_cursores(espaco);
+
+    u = vertice_get_indice(inicial);
+    espaco_visita(espaco, u);
+    cursor[u] = obter_cabeca(vertice_get_arestas(inicial));
+    pilha[topo++] = u;
+
+    while (topo > 0)
+    {
+        u = pilha[topo - 1];
+
+        if (cursor[u] == NULL)
+        {
+            topo--;
+            continue;
+        }
+
+        w = vertice_get_indice(aresta_get_adjacente(obter_dado(cursor[u])));
+        cursor[u] = obtem_proximo(cursor[u]);
+
+        if (!espaco_visitado(espaco, w))
+        {
+            espaco_visita(espaco, w);
+            espaco_set_pai(espaco, w, u);
+            cursor[w] = obter_cabeca(vertice_get_arestas(grafo_get_vertice(grafo, w)));
+            pilha[topo++] = w;
+            visitados++;
+        }
+    }
+
+    return visitados;
+}
+
+/**
+  * @brief  Busca em profundidade
   * @param	grafo: ponteiro do grafo que se deseja executar a busca
   * @param  inicial: ponteiro do vértice inicial (fonte) da busca
   *
   * @retval Nenhum: Vértices são marcados internamente
   */
-void bfs(grafo_t *grafo, vertice_t* inicial)
+void dfs(grafo_t *grafo, vertice_t* inicial)
 {
-    no_t *no;
-    fila_t* fila;
-    arestas_t *aresta;
-    vertice_t *u, *v;
-    lista_enc_t * lista_aresta;
+    espaco_busca_t *espaco = cria_espaco_busca(numero_vertices(grafo), HEAP_DARIO);
 
-    fila = cria_fila();
+    dfs_espaco(grafo, inicial, espaco);
+    copia_para_vertices(grafo, espaco, -1);
 
-    no = obter_cabeca(componentes_conexos(grafo));
+    libera_espaco_busca(espaco);
+}
 
-    while(no)
+/**
+  * @brief  Busca em largura, sem alterar o grafo
+  * @param	grafo: ponteiro do grafo que se deseja executar a busca
+  * @param  inicial: ponteiro do vértice inicial (fonte) da busca
+  * @param  espaco: estado da consulta (reiniciado por esta função)
+  *
+  * A distância no espaço de busca é o número de arestas até a fonte.
+  *
+  * @retval int: número de vértices alcançados
+  */
+int bfs_espaco(grafo_t *grafo, vertice_t* inicial, espaco_busca_t *espaco)
+{
+    int *fila, cabeca = 0, cauda = 0, u, w;
+    no_t *no;
+
+    if (grafo == NULL || inicial == NULL || espaco == NULL)
     {
-        v = obter_dado(no);
-        vertice_set_pai(v,NULL);
-        vertice_set_dist(v, -1);
-        no = obtem_proximo(no);
+        fprintf(stderr, "bfs: parametros invalidos\n");
+        exit(EXIT_FAILURE);
     }
 
-    vertice_set_dist(inicial, 0);
-    enqueue(inicial,fila);
+    espaco_reinicia(espaco);
+    fila = espaco_vetor(espaco);
+
+    u = vertice_get_indice(inicial);
+    espaco_set_dist(espaco, u, 0);
+    espaco_visita(espaco, u);
+    fila[cauda++] = u;
 
-    while(!fila_vazia(fila))
+    while (cabeca < cauda)
     {
-        v = dequeue(fila);
-        lista_aresta = vertice_get_arestas(v);
-        no = obter_cabeca(lista_aresta);
+        u = fila[cabeca++];
+        no = obter_cabeca(vertice_get_arestas(grafo_get_vertice(grafo, u)));
 
-        while(no)
+        while (no)
         {
-            aresta = obter_dado(no);
-            u = aresta_get_adjacente(aresta);
-            if(vertice_get_dist(u)!=-1)
+            w = vertice_get_indice(aresta_get_adjacente(obter_dado(no)));
+            if (!espaco_visitado(espaco, w))
             {
-                enqueue(u, fila);
-                vertice_set_pai(u,v);
-                vertice_set_dist(u,vertice_get_dist(v)+1);
+                espaco_visita(espaco, w);
+                espaco_set_pai(espaco, w, u);
+                espaco_set_dist(espaco, w, espaco_get_dist(espaco, u) + 1);
+                fila[cauda++] = w;
             }
             no = obtem_proximo(no);
         }
     }
+
+    return cauda;
 }
 
-void add_edges(vertice_t *vertice, priority_queue_t *pri_queue) {
-    lista_enc_t *arestas = vertice_get_arestas(vertice);
-    no_t *no;
-    arestas_t *aresta;
+/**
+  * @brief  Busca em largura
+  * @param	grafo: ponteiro do grafo que se deseja executar a busca
+  * @param  inicial: ponteiro do vértice inicial (fonte) da busca
+  *
+  * Executa bfs_csr sobre uma fotografia CSR do grafo e copia o resultado
+  * para os vértices. A versão paralela (bfs_csr_paralelo) fica a critério
+  * de quem chama, diretamente sobre o CSR.
+  *
+  * @retval Nenhum: Vértices são marcados internamente (dist -1: inalcançável)
+  */
+void bfs(grafo_t *grafo, vertice_t* inicial)
+{
+    grafo_csr_t *csr;
+    vertice_t *v;
+    int *dist, *pai, n, i;
 
-    vertice_visitado(vertice, TRUE);
+    if (grafo == NULL || inicial == NULL)
+    {
+        fprintf(stderr, "bfs: parametros invalidos\n");
+        exit(EXIT_FAILURE);
+    }
 
-    no = obter_cabeca(arestas);
-    while(no) {
-      aresta = obter_dado(no);
-      if(vertice_get_visit(aresta_get_adjacente(aresta)) == FALSE)
-        pri_queue->pri_queue[pri_queue->queue_index++] = aresta;
+    n = numero_vertices(grafo);
+    csr = cria_grafo_csr(grafo);
+    dist = malloc(n * sizeof(int));
+    pai = malloc(n * sizeof(int));
 
-      no = obtem_proximo(no);
+    if (dist == NULL || pai == NULL)
+    {
+        perror("bfs:");
+        exit(EXIT_FAILURE);
+    }
+
+    bfs_csr(csr, vertice_get_indice(inicial), dist, pai);
+
+    for (i = 0; i < n; i++)
+    {
+        v = grafo_get_vertice(grafo, i);
+        vertice_set_dist(v, dist[i]);
+        vertice_set_pai(v, pai[i] >= 0 ? grafo_get_vertice(grafo, pai[i]) : NULL);
+        vertice_visitado(v, dist[i] >= 0);
     }
+
+    free(dist);
+    free(pai);
+    libera_grafo_csr(csr);
 }
 
-arestas_t* get_lightest(priority_queue_t *pri_queue) {
+/**
+  * @brief  Árvore geradora mínima pelo algoritmo de Prim, sem alterar o grafo
+  * @param	grafo: grafo não direcionado
+  * @param  id: identificação do vértice raiz da árvore
+  * @param  espaco: estado da consulta (reiniciado por esta função)
+  *
+  * Cada vértice fica na fila no máximo uma vez, com a aresta mais leve que o
+  * liga à árvore: O(E log V) de tempo e O(V) de memória auxiliar. Pesos
+  * iguais são desempatados por desempate_aresta, como em Kruskal e Borůvka,
+  * e a árvore é a mesma deles.
+  *
+  * @retval grafo_t: novo grafo contendo apenas as arestas da árvore
+  */
+grafo_t* prim_espaco(grafo_t* grafo, int id, espaco_busca_t *espaco)
+{
+    int u, w;
+    no_t *no;
     arestas_t *aresta;
-    int index_remov;
+    vertice_t *raiz;
+    grafo_t *prims_graph;
+    fila_prioridade_t *fila;
+
+    raiz = procura_vertice(grafo, id);
+    if (raiz == NULL || espaco == NULL)
+    {
+        fprintf(stderr, "prim_algorithm: vertice %d nao encontrado\n", id);
+        exit(EXIT_FAILURE);
+    }
+
+    espaco_reinicia(espaco);
+    fila = espaco_fila_prioridade(espaco);
+    prims_graph = cria_grafo(id);
+
+    fila_prioridade_inserir(fila, vertice_get_indice(raiz), 0);
+
+    while (!fila_prioridade_vazia(fila))
+    {
+        u = fila_prioridade_remover_min(fila, NULL);
+        espaco_visita(espaco, u);
+
+        if (espaco_get_aresta(espaco, u))
+            adiciona_aresta_grafo(prims_graph, espaco_get_aresta(espaco, u));
 
-    aresta = pri_queue->pri_queue[0];
-    for (int i = 1; i < pri_queue->queue_index; ++i) {
-      if(pri_queue->pri_queue[i]) {
-        if (aresta_get_peso(aresta) > aresta_get_peso(pri_queue->pri_queue[i]))
+        no = obter_cabeca(vertice_get_arestas(grafo_get_vertice(grafo, u)));
+        while (no)
         {
-          aresta = pri_queue->pri_queue[i];
-          index_remov = i;
+            aresta = obter_dado(no);
+            w = vertice_get_indice(aresta_get_adjacente(aresta));
+
+            if (!espaco_visitado(espaco, w) &&
+                fila_prioridade_atualizar_desempate(fila, w, aresta_get_peso(aresta),
+                                                    desempate_aresta(u, w)))
+            {
+                espaco_set_aresta(espaco, w, aresta);
+                espaco_set_pai(espaco, w, u);
+            }
+
+            no = obtem_proximo(no);
         }
-      }
     }
 
-    pri_queue->pri_queue[index_remov] = NULL;
+    return prims_graph;
+}
+
+/**
+  * @brief  Prim com a fila de prioridade escolhida
+  * @param	grafo: grafo não direcionado
+  * @param  id: identificação do vértice raiz da árvore
+  * @param  tipo: implementação da fila de prioridade (HEAP_DARIO ou HEAP_PAREAMENTO)
+  *
+  * @retval grafo_t: novo grafo contendo apenas as arestas da árvore
+  */
+grafo_t* prim_algorithm_fila(grafo_t* grafo, int id, tipo_heap_t tipo)
+{
+    espaco_busca_t *espaco = cria_espaco_busca(numero_vertices(grafo), tipo);
+    grafo_t *prims_graph;
 
-    return aresta;
+    prims_graph = prim_espaco(grafo, id, espaco);
+
+    libera_espaco_busca(espaco);
+
+    return prims_graph;
 }
 
 grafo_t* prim_algorithm(grafo_t* grafo, int id)
 {
-    int count_aresta = 0, m = numero_vertices(grafo) - 1;
-    arestas_t *aresta;
-    vertice_t *v, *destino;
-    grafo_t *prims_graph;
-    priority_queue_t queue;
+    return prim_algorithm_fila(grafo, id, HEAP_DARIO);
+}
 
-    queue.queue_index = 0;
-    queue.queue_size = numero_vertices(grafo)*numero_vertices(grafo)*sizeof(arestas_t*);
-    queue.pri_queue = malloc(queue.queue_size);
-    prims_graph = cria_grafo(id);
+/**
+  * @brief  Prim sobre matriz de adjacência, sem fila de prioridade
+  * @param	matriz: grafo denso
+  * @param  raiz: índice do vértice raiz
+  * @param  pai: vetor do chamador (matriz_num_vertices posições) que recebe
+  *              o pai de cada vértice na árvore. -1 para a raiz e vértices
+  *              fora do componente da raiz
+  *
+  * A cada passo o vértice mais próximo da árvore é escolhido por varredura do
+  * vetor de chaves, e as chaves são relaxadas pela linha contígua da matriz:
+  * O(V^2), ótimo quando E ~ V^2.
+  *
+  * @retval float: peso total da árvore
+  */
+float prim_matriz(grafo_matriz_t *matriz, int raiz, int *pai)
+{
+    int n, i, u, v;
+    float *chave, total = 0;
+    const float *linha;
+    char *na_arvore;
+
+    n = matriz_num_vertices(matriz);
+    if (raiz < 0 || raiz >= n)
+    {
+        fprintf(stderr, "prim_matriz: raiz invalida\n");
+        exit(EXIT_FAILURE);
+    }
+
+    chave = malloc(n * sizeof(float));
+    na_arvore = malloc(n);
+    if (chave == NULL || na_arvore == NULL)
+    {
+        perror("prim_matriz:");
+        exit(EXIT_FAILURE);
+    }
 
-    v = procura_vertice(grafo, id);
-    add_edges(v, &queue);
+    for (i = 0; i < n; i++)
+    {
+        chave[i] = INFINITY;
+        pai[i] = -1;
+        na_arvore[i] = FALSE;
+    }
+    chave[raiz] = 0;
 
-    while((queue.queue_index != 0) && (count_aresta != m))
+    for (i = 0; i < n; i++)
     {
-        aresta = get_lightest(&queue);
-        destino = aresta_get_adjacente(aresta);
+        u = -1;
+        for (v = 0; v < n; v++)
+            if (!na_arvore[v] && (u == -1 || chave[v] < chave[u]))
+                u = v;
 
-        if(vertice_get_visit(destino) == TRUE)
-          continue;
+        if (chave[u] == INFINITY)
+            break;
 
-        count_aresta++;
-        adiciona_aresta_grafo(prims_graph, aresta);
+        na_arvore[u] = TRUE;
+        total += chave[u];
 
-        add_edges(destino, &queue);
+        linha = matriz_linha(matriz, u);
+        for (v = 0; v < n; v++)
+        {
+            if (!na_arvore[v] && linha[v] < chave[v])
+            {
+                chave[v] = linha[v];
+                pai[v] = u;
+            }
+        }
     }
 
-    free(queue.pri_queue);
+    free(chave);
+    free(na_arvore);
 
-    return prims_graph;
+    return total;
 }
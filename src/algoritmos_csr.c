@@ -0,0 +1,836 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <stdint.h>
+
+#include "algoritmos_csr.h"
+#include "fila_prioridade.h"
+#include "paralelo.h"
+
+#define FALSE 0
+#define TRUE 1
+
+/* Limiares de Beamer et al. para a BFS de direcao otimizada: desce para
+ * baixo-para-cima quando as arestas da fronteira passam de 1/ALFA das
+ * arestas ainda nao exploradas, e volta quando a fronteira cai abaixo de
+ * n/BETA vertices */
+#define BFS_ALFA 14
+#define BFS_BETA 24
+
+/* BFS paralela: fronteiras menores que isto sao expandidas por uma so
+ * thread; maiores sao divididas em TAREFAS_POR_THREAD partes por thread */
+#define BFS_PARALELA_MINIMO 4096
+#define BFS_TAREFAS_POR_THREAD 4
+
+#define BITS_PALAVRA 64
+#define BIT_TESTA(mapa, v) (((mapa)[(v) / BITS_PALAVRA] >> ((v) % BITS_PALAVRA)) & 1)
+#define BIT_LIGA(mapa, v) ((mapa)[(v) / BITS_PALAVRA] |= (uint64_t)1 << ((v) % BITS_PALAVRA))
+
+static void verifica_vertice(grafo_csr_t *csr, int v, const char *funcao)
+{
+    if (csr == NULL || v < 0 || v >= csr_num_vertices(csr))
+    {
+        fprintf(stderr, "%s: vertice invalido\n", funcao);
+        exit(EXIT_FAILURE);
+    }
+}
+
+static void *aloca(size_t tamanho, const char *funcao)
+{
+    void *p = malloc(tamanho > 0 ? tamanho : 1);
+
+    if (p == NULL)
+    {
+        perror(funcao);
+        exit(EXIT_FAILURE);
+    }
+
+    return p;
+}
+
+static void verifica_espaco(grafo_csr_t *csr, espaco_busca_t *espaco, const char *funcao)
+{
+    if (espaco == NULL || espaco_num_vertices(espaco) < csr_num_vertices(csr))
+    {
+        fprintf(stderr, "%s: espaco de busca invalido\n", funcao);
+        exit(EXIT_FAILURE);
+    }
+}
+
+/* Copia dist e pai do espaco para os vetores do chamador */
+static void copia_espaco(espaco_busca_t *espaco, int n, float *dist, int *pai)
+{
+    int i;
+
+    for (i = 0; i < n; i++)
+    {
+        if (dist)
+            dist[i] = espaco_get_dist(espaco, i);
+        pai[i] = espaco_get_pai(espaco, i);
+    }
+}
+
+int bfs_csr_espaco(grafo_csr_t *csr, int fonte, espaco_busca_t *espaco)
+{
+    const int *offsets, *vizinhos;
+    int k, u, w, cabeca = 0, cauda = 0, *fila;
+
+    verifica_vertice(csr, fonte, "bfs_csr");
+    verifica_espaco(csr, espaco, "bfs_csr");
+
+    offsets = csr_offsets(csr);
+    vizinhos = csr_vizinhos(csr);
+
+    espaco_reinicia(espaco);
+
+    /* Cada vertice entra uma unica vez: a fila e um vetor de n posicoes */
+    fila = espaco_vetor(espaco);
+
+    espaco_visita(espaco, fonte);
+    espaco_set_dist(espaco, fonte, 0);
+    fila[cauda++] = fonte;
+
+    while (cabeca < cauda)
+    {
+        u = fila[cabeca++];
+        for (k = offsets[u]; k < offsets[u + 1]; k++)
+        {
+            w = vizinhos[k];
+            if (!espaco_visitado(espaco, w))
+            {
+                espaco_visita(espaco, w);
+                espaco_set_dist(espaco, w, espaco_get_dist(espaco, u) + 1);
+                espaco_set_pai(espaco, w, u);
+                fila[cauda++] = w;
+            }
+        }
+    }
+
+    return cauda;
+}
+
+int bfs_csr(grafo_csr_t *csr, int fonte, int *dist, int *pai)
+{
+    espaco_busca_t *espaco;
+    int n, i, alcancados;
+    float d;
+
+    verifica_vertice(csr, fonte, "bfs_csr");
+
+    n = csr_num_vertices(csr);
+    espaco = cria_espaco_busca(n, HEAP_DARIO);
+
+    alcancados = bfs_csr_espaco(csr, fonte, espaco);
+
+    for (i = 0; i < n; i++)
+    {
+        d = espaco_get_dist(espaco, i);
+        dist[i] = d == INFINITY ? -1 : (int)d;
+        pai[i] = espaco_get_pai(espaco, i);
+    }
+
+    libera_espaco_busca(espaco);
+
+    return alcancados;
+}
+
+/* Passo de cima para baixo: examina as arestas de saida da fronteira */
+static int passo_descendente(grafo_csr_t *csr, const int *fronteira, int tamanho,
+                             int *proxima, uint64_t *visitado, int *dist, int *pai,
+                             int nivel)
+{
+    const int *offsets = csr_offsets(csr), *vizinhos = csr_vizinhos(csr);
+    int i, k, u, w, novos = 0;
+
+    for (i = 0; i < tamanho; i++)
+    {
+        u = fronteira[i];
+        for (k = offsets[u]; k < offsets[u + 1]; k++)
+        {
+            w = vizinhos[k];
+            if (!BIT_TESTA(visitado, w))
+            {
+                BIT_LIGA(visitado, w);
+                dist[w] = nivel;
+                pai[w] = u;
+                proxima[novos++] = w;
+            }
+        }
+    }
+
+    return novos;
+}
+
+/* Passo de baixo para cima: cada vertice nao visitado procura um
+ * predecessor na fronteira e para no primeiro encontrado */
+static int passo_ascendente(grafo_csr_t *transposto, const uint64_t *na_fronteira,
+                            int *proxima, uint64_t *visitado, int *dist, int *pai,
+                            int nivel)
+{
+    const int *offsets = csr_offsets(transposto), *vizinhos = csr_vizinhos(transposto);
+    int n = csr_num_vertices(transposto), v, k, u, novos = 0;
+
+    for (v = 0; v < n; v++)
+    {
+        if (BIT_TESTA(visitado, v))
+            continue;
+
+        for (k = offsets[v]; k < offsets[v + 1]; k++)
+        {
+            u = vizinhos[k];
+            if (BIT_TESTA(na_fronteira, u))
+            {
+                dist[v] = nivel;
+                pai[v] = u;
+                proxima[novos++] = v;
+                break;
+            }
+        }
+    }
+
+    /* Marca depois da varredura: um vertice descoberto neste nivel nao
+     * pode servir de predecessor para outro do mesmo nivel */
+    for (k = 0; k < novos; k++)
+        BIT_LIGA(visitado, proxima[k]);
+
+    return novos;
+}
+
+int bfs_csr_direcional(grafo_csr_t *csr, grafo_csr_t *transposto, int fonte,
+                       int *dist, int *pai)
+{
+    const int *offsets;
+    int n, i, palavras, tamanho, novos, nivel = 0, alcancados = 1;
+    int *fronteira, *proxima, *troca, ascendente = FALSE;
+    long arestas_fronteira, arestas_restantes;
+    uint64_t *visitado, *na_fronteira;
+
+    verifica_vertice(csr, fonte, "bfs_csr_direcional");
+    if (transposto == NULL)
+        transposto = csr;
+    else if (csr_num_vertices(transposto) != csr_num_vertices(csr))
+    {
+        fprintf(stderr, "bfs_csr_direcional: transposto invalido\n");
+        exit(EXIT_FAILURE);
+    }
+
+    n = csr_num_vertices(csr);
+    offsets = csr_offsets(csr);
+    palavras = (n + BITS_PALAVRA - 1) / BITS_PALAVRA;
+
+    fronteira = aloca(n * sizeof(int), "bfs_csr_direcional");
+    proxima = aloca(n * sizeof(int), "bfs_csr_direcional");
+    visitado = calloc(palavras > 0 ? palavras : 1, sizeof(uint64_t));
+    na_fronteira = aloca(palavras * sizeof(uint64_t), "bfs_csr_direcional");
+
+    if (visitado == NULL)
+    {
+        perror("bfs_csr_direcional");
+        exit(EXIT_FAILURE);
+    }
+
+    for (i = 0; i < n; i++)
+    {
+        dist[i] = -1;
+        pai[i] = -1;
+    }
+
+    dist[fonte] = 0;
+    BIT_LIGA(visitado, fonte);
+    fronteira[0] = fonte;
+    tamanho = 1;
+    arestas_fronteira = offsets[fonte + 1] - offsets[fonte];
+    arestas_restantes = csr_num_arestas(csr) - arestas_fronteira;
+
+    while (tamanho > 0)
+    {
+        nivel++;
+
+        if (!ascendente && arestas_fronteira > arestas_restantes / BFS_ALFA)
+            ascendente = TRUE;
+        else if (ascendente && tamanho < n / BFS_BETA)
+            ascendente = FALSE;
+
+        if (ascendente)
+        {
+            for (i = 0; i < palavras; i++)
+                na_fronteira[i] = 0;
+            for (i = 0; i < tamanho; i++)
+                BIT_LIGA(na_fronteira, fronteira[i]);
+
+            novos = passo_ascendente(transposto, na_fronteira, proxima,
+                                     visitado, dist, pai, nivel);
+        }
+        else
+            novos = passo_descendente(csr, fronteira, tamanho, proxima,
+                                      visitado, dist, pai, nivel);
+
+        arestas_fronteira = 0;
+        for (i = 0; i < novos; i++)
+            arestas_fronteira += offsets[proxima[i] + 1] - offsets[proxima[i]];
+        arestas_restantes -= arestas_fronteira;
+
+        troca = fronteira;
+        fronteira = proxima;
+        proxima = troca;
+        tamanho = novos;
+        alcancados += novos;
+    }
+
+    free(fronteira);
+    free(proxima);
+    free(visitado);
+    free(na_fronteira);
+
+    return alcancados;
+}
+
+/* Estado de uma BFS paralela. Cada tarefa tem o seu buffer de descobertos,
+ * reaproveitado entre niveis */
+typedef struct bfs_paralela
+{
+    const int *offsets;
+    const int *vizinhos;
+    const int *fronteira;
+    int tamanho;
+    int *proxima;
+    uint64_t *visitado;
+    int *dist;
+    int *pai;
+    int nivel;
+    int num_tarefas;
+    int **buffers;
+    int *usados;
+    int *capacidades;
+    int *inicio_junta;          /*!< Posicao de cada buffer em proxima */
+} bfs_paralela_t;
+
+/* Reivindica v com test-and-set atomico. TRUE para uma unica thread */
+static int reivindica(uint64_t *visitado, int v)
+{
+    uint64_t mascara = (uint64_t)1 << (v % BITS_PALAVRA);
+
+    if (__atomic_load_n(&visitado[v / BITS_PALAVRA], __ATOMIC_RELAXED) & mascara)
+        return FALSE;
+
+    return !(__atomic_fetch_or(&visitado[v / BITS_PALAVRA], mascara, __ATOMIC_RELAXED) & mascara);
+}
+
+static void bfs_expande(void *contexto, int i)
+{
+    bfs_paralela_t *b = contexto;
+    int j, k, u, w, inicio, fim;
+
+    inicio = (int)((long)b->tamanho * i / b->num_tarefas);
+    fim = (int)((long)b->tamanho * (i + 1) / b->num_tarefas);
+    b->usados[i] = 0;
+
+    for (j = inicio; j < fim; j++)
+    {
+        u = b->fronteira[j];
+        for (k = b->offsets[u]; k < b->offsets[u + 1]; k++)
+        {
+            w = b->vizinhos[k];
+            if (!reivindica(b->visitado, w))
+                continue;
+
+            b->dist[w] = b->nivel;
+            b->pai[w] = u;
+
+            if (b->usados[i] == b->capacidades[i])
+            {
+                b->capacidades[i] *= 2;
+                b->buffers[i] = realloc(b->buffers[i], b->capacidades[i] * sizeof(int));
+                if (b->buffers[i] == NULL)
+                {
+                    perror("bfs_csr_paralelo");
+                    exit(EXIT_FAILURE);
+                }
+            }
+            b->buffers[i][b->usados[i]++] = w;
+        }
+    }
+}
+
+static void bfs_junta(void *contexto, int i)
+{
+    bfs_paralela_t *b = contexto;
+
+    memcpy(b->proxima + b->inicio_junta[i], b->buffers[i], b->usados[i] * sizeof(int));
+}
+
+int bfs_csr_paralelo(grafo_csr_t *csr, int fonte, int *dist, int *pai, int num_threads)
+{
+    bfs_paralela_t b;
+    int n, i, threads, alcancados = 1, *fronteira, *troca;
+
+    verifica_vertice(csr, fonte, "bfs_csr_paralelo");
+    if (num_threads < 0)
+    {
+        fprintf(stderr, "bfs_csr_paralelo: numero de threads invalido\n");
+        exit(EXIT_FAILURE);
+    }
+
+    if (num_threads == 0)
+        num_threads = paralelo_num_threads();
+
+    n = csr_num_vertices(csr);
+    b.offsets = csr_offsets(csr);
+    b.vizinhos = csr_vizinhos(csr);
+    b.dist = dist;
+    b.pai = pai;
+    b.num_tarefas = num_threads * BFS_TAREFAS_POR_THREAD;
+
+    fronteira = aloca(n * sizeof(int), "bfs_csr_paralelo");
+    b.proxima = aloca(n * sizeof(int), "bfs_csr_paralelo");
+    b.visitado = calloc((n + BITS_PALAVRA - 1) / BITS_PALAVRA + 1, sizeof(uint64_t));
+    b.buffers = aloca(b.num_tarefas * sizeof(int*), "bfs_csr_paralelo");
+    b.usados = aloca(b.num_tarefas * sizeof(int), "bfs_csr_paralelo");
+    b.capacidades = aloca(b.num_tarefas * sizeof(int), "bfs_csr_paralelo");
+    b.inicio_junta = aloca(b.num_tarefas * sizeof(int), "bfs_csr_paralelo");
+
+    if (b.visitado == NULL)
+    {
+        perror("bfs_csr_paralelo");
+        exit(EXIT_FAILURE);
+    }
+
+    for (i = 0; i < b.num_tarefas; i++)
+    {
+        b.capacidades[i] = 64;
+        b.buffers[i] = aloca(b.capacidades[i] * sizeof(int), "bfs_csr_paralelo");
+    }
+
+    for (i = 0; i < n; i++)
+    {
+        dist[i] = -1;
+        pai[i] = -1;
+    }
+
+    dist[fonte] = 0;
+    BIT_LIGA(b.visitado, fonte);
+    fronteira[0] = fonte;
+    b.tamanho = 1;
+    b.nivel = 0;
+
+    while (b.tamanho > 0)
+    {
+        b.nivel++;
+        b.fronteira = fronteira;
+        threads = b.tamanho < BFS_PARALELA_MINIMO ? 1 : num_threads;
+
+        paralelo_executa(threads, b.num_tarefas, bfs_expande, &b);
+
+        /* Cada buffer vai para uma faixa propria da proxima fronteira */
+        for (i = 0; i < b.num_tarefas; i++)
+        {
+            b.inicio_junta[i] = i == 0 ? 0 : b.inicio_junta[i - 1] + b.usados[i - 1];
+        }
+        b.tamanho = b.inicio_junta[b.num_tarefas - 1] + b.usados[b.num_tarefas - 1];
+
+        paralelo_executa(threads, b.num_tarefas, bfs_junta, &b);
+
+        troca = fronteira;
+        fronteira = b.proxima;
+        b.proxima = troca;
+        alcancados += b.tamanho;
+    }
+
+    for (i = 0; i < b.num_tarefas; i++)
+        free(b.buffers[i]);
+    free(b.buffers);
+    free(b.usados);
+    free(b.capacidades);
+    free(b.inicio_junta);
+    free(b.visitado);
+    free(b.proxima);
+    free(fronteira);
+
+    return alcancados;
+}
+
+int dfs_csr_visitante(grafo_csr_t *csr, int fonte, int *pre, int *pos, int *pai,
+                      visitante_dfs_t *visitante)
+{
+    const int *offsets, *vizinhos;
+    int n, i, r, u, w, k, inicio, fim, topo = 0, num_pre = 0, num_pos = 0;
+    int *pilha, *cursor, *pais;
+    char *visitado;
+
+    if (fonte != -1)
+        verifica_vertice(csr, fonte, "dfs_csr");
+    else if (csr == NULL)
+    {
+        fprintf(stderr, "dfs_csr: grafo invalido\n");
+        exit(EXIT_FAILURE);
+    }
+
+    n = csr_num_vertices(csr);
+    offsets = csr_offsets(csr);
+    vizinhos = csr_vizinhos(csr);
+
+    /* Cada vertice entra na pilha uma unica vez: n posicoes bastam */
+    pilha = aloca(n * sizeof(int), "dfs_csr");
+    cursor = aloca(n * sizeof(int), "dfs_csr");
+    visitado = aloca(n, "dfs_csr");
+    pais = pai ? pai : aloca(n * sizeof(int), "dfs_csr");
+
+    for (i = 0; i < n; i++)
+    {
+        pais[i] = -1;
+        visitado[i] = FALSE;
+    }
+
+    inicio = fonte == -1 ? 0 : fonte;
+    fim = fonte == -1 ? n : fonte + 1;
+
+    for (r = inicio; r < fim; r++)
+    {
+        if (visitado[r])
+            continue;
+
+        visitado[r] = TRUE;
+        if (pre)
+            pre[num_pre] = r;
+        num_pre++;
+        if (visitante && visitante->descoberta)
+            visitante->descoberta(visitante->contexto, r, -1);
+        cursor[r] = offsets[r];
+        pilha[topo++] = r;
+
+        /* Cada vertice guarda a posicao da proxima aresta a examinar */
+        while (topo > 0)
+        {
+            u = pilha[topo - 1];
+
+            if (cursor[u] == offsets[u + 1])
+            {
+                topo--;
+                if (pos)
+                    pos[num_pos] = u;
+                num_pos++;
+                if (visitante && visitante->termino)
+                    visitante->termino(visitante->contexto, u, pais[u]);
+                continue;
+            }
+
+            k = cursor[u]++;
+            w = vizinhos[k];
+            if (!visitado[w])
+            {
+                visitado[w] = TRUE;
+                pais[w] = u;
+                if (pre)
+                    pre[num_pre] = w;
+                num_pre++;
+                if (visitante && visitante->descoberta)
+                    visitante->descoberta(visitante->contexto, w, u);
+                cursor[w] = offsets[w];
+                pilha[topo++] = w;
+            }
+            else if (visitante && visitante->aresta)
+                visitante->aresta(visitante->contexto, u, w, k);
+        }
+    }
+
+    free(pilha);
+    free(cursor);
+    free(visitado);
+    if (pai == NULL)
+        free(pais);
+
+    return num_pre;
+}
+
+int dfs_csr(grafo_csr_t *csr, int fonte, int *ordem, int *pai)
+{
+    verifica_vertice(csr, fonte, "dfs_csr");
+
+    return dfs_csr_visitante(csr, fonte, ordem, NULL, pai, NULL);
+}
+
+float prim_csr_espaco(grafo_csr_t *csr, int raiz, espaco_busca_t *espaco)
+{
+    const int *offsets, *vizinhos;
+    const float *pesos;
+    int k, u, w;
+    float custo, total = 0;
+    fila_prioridade_t *fila;
+
+    verifica_vertice(csr, raiz, "prim_csr");
+    verifica_espaco(csr, espaco, "prim_csr");
+
+    offsets = csr_offsets(csr);
+    vizinhos = csr_vizinhos(csr);
+    pesos = csr_pesos(csr);
+
+    espaco_reinicia(espaco);
+    fila = espaco_fila_prioridade(espaco);
+
+    /* dist guarda a chave: peso da aresta mais leve ate a arvore */
+    espaco_set_dist(espaco, raiz, 0);
+    fila_prioridade_inserir(fila, raiz, 0);
+
+    while (!fila_prioridade_vazia(fila))
+    {
+        u = fila_prioridade_remover_min(fila, &custo);
+        espaco_visita(espaco, u);
+        total += custo;
+
+        for (k = offsets[u]; k < offsets[u + 1]; k++)
+        {
+            w = vizinhos[k];
+            if (!espaco_visitado(espaco, w) && pesos[k] < espaco_get_dist(espaco, w))
+            {
+                espaco_set_dist(espaco, w, pesos[k]);
+                espaco_set_pai(espaco, w, u);
+                fila_prioridade_atualizar(fila, w, pesos[k]);
+            }
+        }
+    }
+
+    return total;
+}
+
+float prim_csr(grafo_csr_t *csr, int raiz, int *pai, float *peso)
+{
+    espaco_busca_t *espaco;
+    int n, i;
+    float total;
+
+    verifica_vertice(csr, raiz, "prim_csr");
+
+    n = csr_num_vertices(csr);
+    espaco = cria_espaco_busca(n, HEAP_DARIO);
+
+    total = prim_csr_espaco(csr, raiz, espaco);
+    copia_espaco(espaco, n, NULL, pai);
+
+    if (peso)
+        for (i = 0; i < n; i++)
+            peso[i] = pai[i] >= 0 ? espaco_get_dist(espaco, i) : 0;
+
+    libera_espaco_busca(espaco);
+
+    return total;
+}
+
+float dijkstra_csr_espaco(grafo_csr_t *csr, int fonte, int destino,
+                          espaco_busca_t *espaco)
+{
+    const int *offsets, *vizinhos;
+    const float *pesos;
+    int k, u, w;
+    float d, nova;
+    fila_prioridade_t *fila;
+
+    verifica_vertice(csr, fonte, "dijkstra_csr");
+    if (destino != -1)
+        verifica_vertice(csr, destino, "dijkstra_csr");
+    verifica_espaco(csr, espaco, "dijkstra_csr");
+
+    offsets = csr_offsets(csr);
+    vizinhos = csr_vizinhos(csr);
+    pesos = csr_pesos(csr);
+
+    espaco_reinicia(espaco);
+    fila = espaco_fila_prioridade(espaco);
+
+    espaco_set_dist(espaco, fonte, 0);
+    fila_prioridade_inserir(fila, fonte, 0);
+
+    while (!fila_prioridade_vazia(fila))
+    {
+        u = fila_prioridade_remover_min(fila, &d);
+        espaco_visita(espaco, u);
+        if (u == destino)
+            break;
+
+        for (k = offsets[u]; k < offsets[u + 1]; k++)
+        {
+            w = vizinhos[k];
+            nova = d + pesos[k];
+            if (nova < espaco_get_dist(espaco, w))
+            {
+                espaco_set_dist(espaco, w, nova);
+                espaco_set_pai(espaco, w, u);
+                fila_prioridade_atualizar(fila, w, nova);
+            }
+        }
+    }
+
+    return destino == -1 ? 0 : espaco_get_dist(espaco, destino);
+}
+
+float dijkstra_csr(grafo_csr_t *csr, int fonte, int destino, float *dist, int *pai)
+{
+    espaco_busca_t *espaco;
+    float d;
+
+    verifica_vertice(csr, fonte, "dijkstra_csr");
+
+    espaco = cria_espaco_busca(csr_num_vertices(csr), HEAP_DARIO);
+
+    d = dijkstra_csr_espaco(csr, fonte, destino, espaco);
+    copia_espaco(espaco, csr_num_vertices(csr), dist, pai);
+
+    libera_espaco_busca(espaco);
+
+    return d;
+}
+
+/* Retira o menor vertice de um dos sentidos e relaxa suas arestas em g.
+ * Cada rotulo tocado que o outro sentido tambem alcancou fecha um caminho
+ * fonte..w..destino de custo dist(este, w) + dist(outro, w) */
+static void bidirecional_avanca(grafo_csr_t *g, espaco_busca_t *este,
+                                espaco_busca_t *outro, float *melhor, int *encontro)
+{
+    const int *offsets = csr_offsets(g), *vizinhos = csr_vizinhos(g);
+    const float *pesos = csr_pesos(g);
+    fila_prioridade_t *fila = espaco_fila_prioridade(este);
+    int k, u, w;
+    float d, nova, total;
+
+    u = fila_prioridade_remover_min(fila, &d);
+    espaco_visita(este, u);
+
+    for (k = offsets[u]; k < offsets[u + 1]; k++)
+    {
+        w = vizinhos[k];
+        nova = d + pesos[k];
+        if (nova < espaco_get_dist(este, w))
+        {
+            espaco_set_dist(este, w, nova);
+            espaco_set_pai(este, w, u);
+            fila_prioridade_atualizar(fila, w, nova);
+        }
+
+        total = espaco_get_dist(este, w) + espaco_get_dist(outro, w);
+        if (total < *melhor)
+        {
+            *melhor = total;
+            *encontro = w;
+        }
+    }
+}
+
+float dijkstra_csr_bidirecional(grafo_csr_t *csr, grafo_csr_t *transposto,
+                                int fonte, int destino, espaco_busca_t *frente,
+                                espaco_busca_t *tras, int *encontro)
+{
+    fila_prioridade_t *fila_frente, *fila_tras;
+    float melhor = INFINITY, min_frente, min_tras;
+    int meio = -1;
+
+    verifica_vertice(csr, fonte, "dijkstra_csr_bidirecional");
+    verifica_vertice(csr, destino, "dijkstra_csr_bidirecional");
+    verifica_espaco(csr, frente, "dijkstra_csr_bidirecional");
+    verifica_espaco(csr, tras, "dijkstra_csr_bidirecional");
+    if (transposto == NULL)
+        transposto = csr;
+    else if (csr_num_vertices(transposto) != csr_num_vertices(csr))
+    {
+        fprintf(stderr, "dijkstra_csr_bidirecional: transposto invalido\n");
+        exit(EXIT_FAILURE);
+    }
+    if (frente == tras || encontro == NULL)
+    {
+        fprintf(stderr, "dijkstra_csr_bidirecional: parametros invalidos\n");
+        exit(EXIT_FAILURE);
+    }
+
+    espaco_reinicia(frente);
+    espaco_reinicia(tras);
+    fila_frente = espaco_fila_prioridade(frente);
+    fila_tras = espaco_fila_prioridade(tras);
+
+    espaco_set_dist(frente, fonte, 0);
+    fila_prioridade_inserir(fila_frente, fonte, 0);
+    espaco_set_dist(tras, destino, 0);
+    fila_prioridade_inserir(fila_tras, destino, 0);
+
+    if (fonte == destino)
+    {
+        melhor = 0;
+        meio = fonte;
+    }
+
+    while (!fila_prioridade_vazia(fila_frente) && !fila_prioridade_vazia(fila_tras))
+    {
+        fila_prioridade_minimo(fila_frente, &min_frente);
+        fila_prioridade_minimo(fila_tras, &min_tras);
+        if (min_frente + min_tras >= melhor)
+            break;
+
+        if (min_frente <= min_tras)
+            bidirecional_avanca(csr, frente, tras, &melhor, &meio);
+        else
+            bidirecional_avanca(transposto, tras, frente, &melhor, &meio);
+    }
+
+    *encontro = meio;
+
+    return melhor;
+}
+
+int caminho_csr_bidirecional(espaco_busca_t *frente, espaco_busca_t *tras,
+                             int encontro, int *caminho, int max)
+{
+    int tamanho, metade = 0, i, v;
+
+    if (frente == NULL || tras == NULL || encontro >= espaco_num_vertices(frente))
+    {
+        fprintf(stderr, "caminho_csr_bidirecional: parametros invalidos\n");
+        exit(EXIT_FAILURE);
+    }
+
+    if (encontro < 0)
+        return 0;
+
+    /* Pais de frente levam de volta a fonte; pais de tras seguem ao destino */
+    for (v = encontro; v >= 0; v = espaco_get_pai(frente, v))
+        metade++;
+    tamanho = metade;
+    for (v = espaco_get_pai(tras, encontro); v >= 0; v = espaco_get_pai(tras, v))
+        tamanho++;
+
+    if (tamanho > max || caminho == NULL)
+        return tamanho;
+
+    i = metade - 1;
+    for (v = encontro; v >= 0; v = espaco_get_pai(frente, v))
+        caminho[i--] = v;
+
+    i = metade;
+    for (v = espaco_get_pai(tras, encontro); v >= 0; v = espaco_get_pai(tras, v))
+        caminho[i++] = v;
+
+    return tamanho;
+}
+
+int caminho_csr_espaco(espaco_busca_t *espaco, int destino, int *caminho, int max)
+{
+    int tamanho = 0, i, v;
+
+    if (espaco == NULL || destino < 0 || destino >= espaco_num_vertices(espaco))
+    {
+        fprintf(stderr, "caminho_csr_espaco: parametros invalidos\n");
+        exit(EXIT_FAILURE);
+    }
+
+    if (espaco_get_dist(espaco, destino) == INFINITY)
+        return 0;
+
+    for (v = destino; v >= 0; v = espaco_get_pai(espaco, v))
+        tamanho++;
+
+    if (tamanho > max || caminho == NULL)
+        return tamanho;
+
+    i = tamanho - 1;
+    for (v = destino; v >= 0; v = espaco_get_pai(espaco, v))
+        caminho[i--] = v;
+
+    return tamanho;
+}
@@ -0,0 +1,428 @@
+/*
+ * algoritmos_inteiros.c
+ *
+ * Filas de baldes para pesos inteiros: listas duplamente encadeadas em
+ * vetores (Dial e Prim) e heap radix com remocao preguicosa.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "algoritmos_inteiros.h"
+
+#define FALSE 0
+#define TRUE 1
+
+/* Baldes do heap radix: chave igual ao ultimo minimo, mais um por bit */
+#define RADIX_BALDES 33
+
+static void *aloca(size_t tamanho)
+{
+    void *p = malloc(tamanho > 0 ? tamanho : 1);
+
+    if (p == NULL)
+    {
+        perror("algoritmos_inteiros:");
+        exit(EXIT_FAILURE);
+    }
+
+    return p;
+}
+
+static void verifica(grafo_csr_t *csr, int v, const char *funcao)
+{
+    if (csr == NULL || v < 0 || v >= csr_num_vertices(csr))
+    {
+        fprintf(stderr, "%s: vertice invalido\n", funcao);
+        exit(EXIT_FAILURE);
+    }
+
+    if (csr_pesos_inteiros(csr) == NULL)
+    {
+        fprintf(stderr, "%s: pesos nao inteiros\n", funcao);
+        exit(EXIT_FAILURE);
+    }
+}
+
+/* Baldes de listas duplamente encadeadas: remocao de um vertice qualquer
+ * em O(1), necessaria para diminuir a chave */
+typedef struct baldes
+{
+    int num_baldes;
+    int *cabeca;        /*!< Primeiro vertice de cada balde. -1 se vazio */
+    int *prox;
+    int *ant;
+    int *balde;         /*!< Balde de cada vertice. -1 fora da fila */
+} baldes_t;
+
+static void cria_baldes(baldes_t *b, int num_baldes, int n)
+{
+    int i;
+
+    b->num_baldes = num_baldes;
+    b->cabeca = aloca(num_baldes * sizeof(int));
+    b->prox = aloca(n * sizeof(int));
+    b->ant = aloca(n * sizeof(int));
+    b->balde = aloca(n * sizeof(int));
+
+    for (i = 0; i < num_baldes; i++)
+        b->cabeca[i] = -1;
+    for (i = 0; i < n; i++)
+        b->balde[i] = -1;
+}
+
+static void libera_baldes(baldes_t *b)
+{
+    free(b->cabeca);
+    free(b->prox);
+    free(b->ant);
+    free(b->balde);
+}
+
+static void baldes_insere(baldes_t *b, int v, int i)
+{
+    b->balde[v] = i;
+    b->ant[v] = -1;
+    b->prox[v] = b->cabeca[i];
+    if (b->cabeca[i] >= 0)
+        b->ant[b->cabeca[i]] = v;
+    b->cabeca[i] = v;
+}
+
+static void baldes_remove(baldes_t *b, int v)
+{
+    if (b->ant[v] >= 0)
+        b->prox[b->ant[v]] = b->prox[v];
+    else
+        b->cabeca[b->balde[v]] = b->prox[v];
+
+    if (b->prox[v] >= 0)
+        b->ant[b->prox[v]] = b->ant[v];
+
+    b->balde[v] = -1;
+}
+
+/**
+  * @brief  Dijkstra com a fila de baldes de Dial
+  * @param  csr: grafo com pesos inteiros
+  * @param  fonte: indice do vertice de origem
+  * @param  destino: indice do destino, ou -1 para todos os vertices
+  * @param  dist: recebe as distancias (-1 se inalcancavel)
+  * @param  pai: recebe o antecessor no menor caminho
+  *
+  * Toda chave na fila esta em [atual, atual + C], portanto C + 1 baldes
+  * circulares bastam e o balde de uma chave d e d % (C + 1). O cursor so
+  * avanca.
+  *
+  * @retval int: distancia ate destino (-1 se inalcancavel, 0 se destino == -1)
+  */
+int dijkstra_csr_dial(grafo_csr_t *csr, int fonte, int destino, int *dist, int *pai)
+{
+    const int *offsets, *vizinhos, *pesos;
+    baldes_t b;
+    int n, i, k, u, w, nova, atual = 0, na_fila = 1;
+    char *fechado;
+
+    verifica(csr, fonte, "dijkstra_csr_dial");
+    if (destino != -1)
+        verifica(csr, destino, "dijkstra_csr_dial");
+
+    n = csr_num_vertices(csr);
+    offsets = csr_offsets(csr);
+    vizinhos = csr_vizinhos(csr);
+    pesos = csr_pesos_inteiros(csr);
+
+    cria_baldes(&b, csr_peso_maximo(csr) + 1, n);
+    fechado = aloca(n);
+
+    for (i = 0; i < n; i++)
+    {
+        dist[i] = -1;
+        pai[i] = -1;
+        fechado[i] = FALSE;
+    }
+
+    dist[fonte] = 0;
+    baldes_insere(&b, fonte, 0);
+
+    while (na_fila > 0)
+    {
+        while (b.cabeca[atual % b.num_baldes] < 0)
+            atual++;
+
+        u = b.cabeca[atual % b.num_baldes];
+        baldes_remove(&b, u);
+        na_fila--;
+        fechado[u] = TRUE;
+        if (u == destino)
+            break;
+
+        for (k = offsets[u]; k < offsets[u + 1]; k++)
+        {
+            w = vizinhos[k];
+            nova = atual + pesos[k];
+            if (fechado[w] || (dist[w] >= 0 && nova >= dist[w]))
+                continue;
+
+            if (b.balde[w] >= 0)
+                baldes_remove(&b, w);
+            else
+                na_fila++;
+
+            dist[w] = nova;
+            pai[w] = u;
+            baldes_insere(&b, w, nova % b.num_baldes);
+        }
+    }
+
+    libera_baldes(&b);
+    free(fechado);
+
+    return destino == -1 ? 0 : dist[destino];
+}
+
+/* Heap radix monotono (Ahuja, Mehlhorn, Orlin e Tarjan). Sem diminuicao
+ * de chave: o vertice e reinserido e as copias antigas sao descartadas na
+ * extracao */
+typedef struct item_radix
+{
+    unsigned chave;
+    int v;
+} item_radix_t;
+
+typedef struct radix
+{
+    item_radix_t *itens[RADIX_BALDES];
+    int tamanho[RADIX_BALDES];
+    int capacidade[RADIX_BALDES];
+    unsigned ultimo;    /*!< Ultima chave extraida: nenhuma chave e menor */
+    int total;
+} radix_t;
+
+/* Balde da chave: 0 se igual ao ultimo minimo, senao 1 + o bit mais alto
+ * em que difere dele */
+static int radix_balde(radix_t *r, unsigned chave)
+{
+    unsigned x = chave ^ r->ultimo;
+    int i = 0;
+
+    if (x == 0)
+        return 0;
+
+#ifdef __GNUC__
+    i = 32 - __builtin_clz(x);
+#else
+    while (x)
+    {
+        x >>= 1;
+        i++;
+    }
+#endif
+
+    return i;
+}
+
+static void radix_insere(radix_t *r, unsigned chave, int v)
+{
+    int i = radix_balde(r, chave);
+
+    if (r->tamanho[i] == r->capacidade[i])
+    {
+        r->capacidade[i] = r->capacidade[i] ? 2 * r->capacidade[i] : 16;
+        r->itens[i] = realloc(r->itens[i], r->capacidade[i] * sizeof(item_radix_t));
+        if (r->itens[i] == NULL)
+        {
+            perror("algoritmos_inteiros:");
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    r->itens[i][r->tamanho[i]].chave = chave;
+    r->itens[i][r->tamanho[i]].v = v;
+    r->tamanho[i]++;
+    r->total++;
+}
+
+/* Extrai um item de chave minima. Se o balde 0 estiver vazio, o primeiro
+ * balde nao vazio e redistribuido a partir do seu minimo: todos os itens
+ * caem em baldes menores */
+static int radix_remove_min(radix_t *r, unsigned *chave)
+{
+    item_radix_t *itens;
+    int i, j, tamanho;
+    unsigned minimo;
+
+    if (r->tamanho[0] == 0)
+    {
+        for (i = 1; r->tamanho[i] == 0; i++)
+            ;
+
+        itens = r->itens[i];
+        tamanho = r->tamanho[i];
+        minimo = itens[0].chave;
+        for (j = 1; j < tamanho; j++)
+            if (itens[j].chave < minimo)
+                minimo = itens[j].chave;
+
+        r->ultimo = minimo;
+        r->tamanho[i] = 0;
+        r->total -= tamanho;
+        for (j = 0; j < tamanho; j++)
+            radix_insere(r, itens[j].chave, itens[j].v);
+    }
+
+    r->tamanho[0]--;
+    r->total--;
+    *chave = r->itens[0][r->tamanho[0]].chave;
+
+    return r->itens[0][r->tamanho[0]].v;
+}
+
+/**
+  * @brief  Dijkstra com heap radix
+  * @param  csr: grafo com pesos inteiros
+  * @param  fonte: indice do vertice de origem
+  * @param  destino: indice do destino, ou -1 para todos os vertices
+  * @param  dist: recebe as distancias (-1 se inalcancavel)
+  * @param  pai: recebe o antecessor no menor caminho
+  *
+  * Chaves extraidas em ordem nao decrescente, como exige o heap radix.
+  * Cada aresta relaxada com sucesso insere uma copia do vertice.
+  *
+  * @retval int: distancia ate destino (-1 se inalcancavel, 0 se destino == -1)
+  */
+int dijkstra_csr_radix(grafo_csr_t *csr, int fonte, int destino, int *dist, int *pai)
+{
+    const int *offsets, *vizinhos, *pesos;
+    radix_t r;
+    int n, i, k, u, w, nova;
+    unsigned chave;
+    char *fechado;
+
+    verifica(csr, fonte, "dijkstra_csr_radix");
+    if (destino != -1)
+        verifica(csr, destino, "dijkstra_csr_radix");
+
+    n = csr_num_vertices(csr);
+    offsets = csr_offsets(csr);
+    vizinhos = csr_vizinhos(csr);
+    pesos = csr_pesos_inteiros(csr);
+
+    for (i = 0; i < RADIX_BALDES; i++)
+    {
+        r.itens[i] = NULL;
+        r.tamanho[i] = 0;
+        r.capacidade[i] = 0;
+    }
+    r.ultimo = 0;
+    r.total = 0;
+
+    fechado = aloca(n);
+    for (i = 0; i < n; i++)
+    {
+        dist[i] = -1;
+        pai[i] = -1;
+        fechado[i] = FALSE;
+    }
+
+    dist[fonte] = 0;
+    radix_insere(&r, 0, fonte);
+
+    while (r.total > 0)
+    {
+        u = radix_remove_min(&r, &chave);
+        if (fechado[u])
+            continue;
+
+        fechado[u] = TRUE;
+        if (u == destino)
+            break;
+
+        for (k = offsets[u]; k < offsets[u + 1]; k++)
+        {
+            w = vizinhos[k];
+            nova = (int) chave + pesos[k];
+            if (fechado[w] || (dist[w] >= 0 && nova >= dist[w]))
+                continue;
+
+            dist[w] = nova;
+            pai[w] = u;
+            radix_insere(&r, (unsigned) nova, w);
+        }
+    }
+
+    for (i = 0; i < RADIX_BALDES; i++)
+        free(r.itens[i]);
+    free(fechado);
+
+    return destino == -1 ? 0 : dist[destino];
+}
+
+int prim_csr_baldes(grafo_csr_t *csr, int raiz, int *pai, int *peso)
+{
+    const int *offsets, *vizinhos, *pesos;
+    baldes_t b;
+    int n, i, k, u, w, *chave, cursor = 0, na_fila = 1, total = 0;
+    char *fechado;
+
+    verifica(csr, raiz, "prim_csr_baldes");
+
+    n = csr_num_vertices(csr);
+    offsets = csr_offsets(csr);
+    vizinhos = csr_vizinhos(csr);
+    pesos = csr_pesos_inteiros(csr);
+
+    cria_baldes(&b, csr_peso_maximo(csr) + 1, n);
+    chave = aloca(n * sizeof(int));
+    fechado = aloca(n);
+
+    for (i = 0; i < n; i++)
+    {
+        chave[i] = -1;
+        pai[i] = -1;
+        fechado[i] = FALSE;
+    }
+
+    chave[raiz] = 0;
+    baldes_insere(&b, raiz, 0);
+
+    while (na_fila > 0)
+    {
+        while (b.cabeca[cursor] < 0)
+            cursor++;
+
+        u = b.cabeca[cursor];
+        baldes_remove(&b, u);
+        na_fila--;
+        fechado[u] = TRUE;
+        total += chave[u];
+
+        for (k = offsets[u]; k < offsets[u + 1]; k++)
+        {
+            w = vizinhos[k];
+            if (fechado[w] || (chave[w] >= 0 && pesos[k] >= chave[w]))
+                continue;
+
+            if (b.balde[w] >= 0)
+                baldes_remove(&b, w);
+            else
+                na_fila++;
+
+            chave[w] = pesos[k];
+            pai[w] = u;
+            baldes_insere(&b, w, pesos[k]);
+            if (pesos[k] < cursor)
+                cursor = pesos[k];
+        }
+    }
+
+    if (peso)
+        for (i = 0; i < n; i++)
+            peso[i] = pai[i] >= 0 ? chave[i] : 0;
+
+    libera_baldes(&b);
+    free(chave);
+    free(fechado);
+
+    return total;
+}
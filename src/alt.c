@@ -0,0 +1,510 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "alt.h"
+#include "algoritmos_csr.h"
+#include "paralelo.h"
+
+#define FALSE 0
+#define TRUE 1
+
+#define ALT_MAGICO "GTALT01"
+
+/* Cabecalho do arquivo, seguido de n ids, dos marcos (int32) e das
+ * tabelas de distancias, que comecam em um deslocamento multiplo de 8 */
+typedef struct cabecalho_alt
+{
+    char magico[8];
+    int32_t n;
+    int32_t num_marcos;
+    int32_t simetrico;
+    int32_t reservado;
+} cabecalho_alt_t;
+
+/* As distancias de um vertice a todos os marcos ficam contiguas: o limite
+ * de um vertice le uma unica linha de cada tabela */
+struct alt
+{
+    int n;
+    int k;                      /*!< Numero de marcos */
+    int simetrico;              /*!< Grafo nao direcionado: para == de */
+    int32_t *ids;
+    int32_t *marcos;
+    float *de;                  /*!< de[v * k + i] = d(marco i, v) */
+    float *para;                /*!< para[v * k + i] = d(v, marco i) */
+
+    void *mapa;                 /*!< Regiao de mmap, NULL se em malloc */
+    size_t tamanho_mapa;
+};
+
+static void *aloca(size_t tamanho)
+{
+    void *p = malloc(tamanho > 0 ? tamanho : 1);
+
+    if (p == NULL)
+    {
+        perror("alt:");
+        exit(EXIT_FAILURE);
+    }
+
+    return p;
+}
+
+/* Deslocamento da primeira tabela no arquivo */
+static size_t inicio_tabelas(int n, int k)
+{
+    size_t inicio = sizeof(cabecalho_alt_t) + ((size_t)n + k) * sizeof(int32_t);
+
+    return (inicio + 7) & ~(size_t)7;
+}
+
+/* Vertice nao marco mais distante dos marcos ja escolhidos */
+static int mais_distante(const float *proximidade, const char *escolhido, int n)
+{
+    int v, melhor = -1;
+
+    for (v = 0; v < n; v++)
+        if (!escolhido[v] && (melhor < 0 || proximidade[v] > proximidade[melhor]))
+            melhor = v;
+
+    return melhor;
+}
+
+typedef struct reverso
+{
+    grafo_csr_t *transposto;
+    alt_t *alt;
+    int proximo;                /*!< Proximo marco a calcular */
+} reverso_t;
+
+/* Uma tarefa por thread: Dijkstra no transposto a partir de cada marco */
+static void calcula_para(void *contexto, int t)
+{
+    reverso_t *r = contexto;
+    alt_t *alt = r->alt;
+    espaco_busca_t *espaco;
+    int i, v;
+
+    (void)t;
+    espaco = cria_espaco_busca(alt->n, HEAP_DARIO);
+
+    for (;;)
+    {
+        i = __atomic_fetch_add(&r->proximo, 1, __ATOMIC_RELAXED);
+        if (i >= alt->k)
+            break;
+
+        dijkstra_csr_espaco(r->transposto, alt->marcos[i], -1, espaco);
+        for (v = 0; v < alt->n; v++)
+            alt->para[(size_t)v * alt->k + i] = espaco_get_dist(espaco, v);
+    }
+
+    libera_espaco_busca(espaco);
+}
+
+/**
+  * @brief  Escolhe os marcos e calcula as distâncias de e para cada um
+  * @param	csr: grafo com pesos não negativos
+  * @param  transposto: fotografia transposta, ou NULL se não direcionado
+  * @param  num_marcos: número de marcos
+  * @param  num_threads: número de threads (0: uma por núcleo)
+  *
+  * A escolha de cada marco depende das distâncias dos anteriores, então
+  * as buscas a partir dos marcos são sequenciais; as buscas até os marcos,
+  * no transposto, são independentes e correm em paralelo.
+  *
+  * @retval alt_t: tabela de marcos em memória
+  */
+alt_t *cria_alt(grafo_csr_t *csr, grafo_csr_t *transposto, int num_marcos, int num_threads)
+{
+    alt_t *alt;
+    espaco_busca_t *espaco;
+    float *proximidade, dist;
+    char *escolhido;
+    reverso_t r;
+    int n, i, v, marco;
+
+    if (csr == NULL || num_marcos < 1 || num_marcos > csr_num_vertices(csr) ||
+        num_threads < 0 ||
+        (transposto != NULL && csr_num_vertices(transposto) != csr_num_vertices(csr)))
+    {
+        fprintf(stderr, "cria_alt: parametros invalidos\n");
+        exit(EXIT_FAILURE);
+    }
+
+    n = csr_num_vertices(csr);
+
+    alt = aloca(sizeof(alt_t));
+    alt->n = n;
+    alt->k = num_marcos;
+    alt->simetrico = transposto == NULL;
+    alt->ids = aloca(n * sizeof(int32_t));
+    alt->marcos = aloca(num_marcos * sizeof(int32_t));
+    alt->de = aloca((size_t)n * num_marcos * sizeof(float));
+    alt->para = alt->simetrico ? alt->de : aloca((size_t)n * num_marcos * sizeof(float));
+    alt->mapa = NULL;
+    alt->tamanho_mapa = 0;
+
+    for (v = 0; v < n; v++)
+        alt->ids[v] = csr_id(csr, v);
+
+    espaco = cria_espaco_busca(n, HEAP_DARIO);
+    proximidade = aloca(n * sizeof(float));
+    escolhido = calloc(n, 1);
+    if (escolhido == NULL)
+    {
+        perror("cria_alt:");
+        exit(EXIT_FAILURE);
+    }
+
+    /* O primeiro marco e o mais distante do vertice 0 */
+    dijkstra_csr_espaco(csr, 0, -1, espaco);
+    for (v = 0; v < n; v++)
+        proximidade[v] = espaco_get_dist(espaco, v);
+    marco = mais_distante(proximidade, escolhido, n);
+
+    for (v = 0; v < n; v++)
+        proximidade[v] = INFINITY;
+
+    for (i = 0; i < num_marcos; i++)
+    {
+        alt->marcos[i] = marco;
+        escolhido[marco] = TRUE;
+
+        dijkstra_csr_espaco(csr, marco, -1, espaco);
+        for (v = 0; v < n; v++)
+        {
+            dist = espaco_get_dist(espaco, v);
+            alt->de[(size_t)v * num_marcos + i] = dist;
+            if (dist < proximidade[v])
+                proximidade[v] = dist;
+        }
+
+        if (i + 1 < num_marcos)
+            marco = mais_distante(proximidade, escolhido, n);
+    }
+
+    libera_espaco_busca(espaco);
+    free(proximidade);
+    free(escolhido);
+
+    if (!alt->simetrico)
+    {
+        if (num_threads == 0)
+            num_threads = paralelo_num_threads();
+
+        r.transposto = transposto;
+        r.alt = alt;
+        r.proximo = 0;
+        paralelo_executa(num_threads, num_threads < num_marcos ? num_threads : num_marcos,
+                         calcula_para, &r);
+    }
+
+    return alt;
+}
+
+/**
+  * @brief  Grava a tabela de marcos em arquivo binário
+  * @param	alt: tabela calculada ou carregada
+  * @param  arquivo: caminho do arquivo (ex.: tempo.csv.alt)
+  *
+  * O arquivo usa a ordem de bytes da máquina.
+  *
+  * @retval Nenhum
+  */
+void salva_alt(alt_t *alt, const char *arquivo)
+{
+    cabecalho_alt_t c;
+    static const char zeros[8] = {0};
+    size_t preenchimento, elementos;
+    FILE *fp;
+
+    if (alt == NULL || arquivo == NULL)
+    {
+        fprintf(stderr, "salva_alt: parametros invalidos\n");
+        exit(EXIT_FAILURE);
+    }
+
+    fp = fopen(arquivo, "wb");
+    if (fp == NULL)
+    {
+        perror("salva_alt:");
+        exit(EXIT_FAILURE);
+    }
+
+    memset(&c, 0, sizeof(c));
+    memcpy(c.magico, ALT_MAGICO, sizeof(c.magico));
+    c.n = alt->n;
+    c.num_marcos = alt->k;
+    c.simetrico = alt->simetrico;
+
+    preenchimento = inicio_tabelas(c.n, c.num_marcos) - sizeof(c) -
+                    ((size_t)c.n + c.num_marcos) * sizeof(int32_t);
+    elementos = (size_t)c.n * c.num_marcos;
+
+    if (fwrite(&c, sizeof(c), 1, fp) != 1 ||
+        fwrite(alt->ids, sizeof(int32_t), c.n, fp) != (size_t)c.n ||
+        fwrite(alt->marcos, sizeof(int32_t), c.num_marcos, fp) != (size_t)c.num_marcos ||
+        fwrite(zeros, 1, preenchimento, fp) != preenchimento ||
+        fwrite(alt->de, sizeof(float), elementos, fp) != elementos ||
+        (!alt->simetrico && fwrite(alt->para, sizeof(float), elementos, fp) != elementos) ||
+        fclose(fp) != 0)
+    {
+        perror("salva_alt:");
+        exit(EXIT_FAILURE);
+    }
+}
+
+/**
+  * @brief  Abre uma tabela gravada por salva_alt
+  * @param	arquivo: caminho do arquivo
+  * @param  csr: grafo das consultas
+  *
+  * @retval alt_t: tabela somente leitura, mapeada na memória
+  */
+alt_t *carrega_alt(const char *arquivo, grafo_csr_t *csr)
+{
+    cabecalho_alt_t c;
+    struct stat info;
+    alt_t *alt;
+    size_t elementos;
+    int fd, v;
+
+    if (arquivo == NULL || csr == NULL)
+    {
+        fprintf(stderr, "carrega_alt: parametros invalidos\n");
+        exit(EXIT_FAILURE);
+    }
+
+    fd = open(arquivo, O_RDONLY);
+    if (fd < 0)
+    {
+        perror("carrega_alt:");
+        exit(EXIT_FAILURE);
+    }
+
+    if (fstat(fd, &info) != 0 || (size_t)info.st_size < sizeof(c))
+    {
+        fprintf(stderr, "carrega_alt: arquivo invalido: %s\n", arquivo);
+        exit(EXIT_FAILURE);
+    }
+
+    alt = aloca(sizeof(alt_t));
+    alt->tamanho_mapa = info.st_size;
+    alt->mapa = mmap(NULL, alt->tamanho_mapa, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+
+    if (alt->mapa == MAP_FAILED)
+    {
+        perror("carrega_alt:");
+        exit(EXIT_FAILURE);
+    }
+
+    memcpy(&c, alt->mapa, sizeof(c));
+    elementos = (size_t)c.n * c.num_marcos;
+    if (memcmp(c.magico, ALT_MAGICO, sizeof(c.magico)) != 0 || c.n < 0 ||
+        c.num_marcos < 1 || c.num_marcos > c.n ||
+        alt->tamanho_mapa < inicio_tabelas(c.n, c.num_marcos) +
+                            (c.simetrico ? 1 : 2) * elementos * sizeof(float))
+    {
+        fprintf(stderr, "carrega_alt: arquivo invalido: %s\n", arquivo);
+        exit(EXIT_FAILURE);
+    }
+
+    alt->n = c.n;
+    alt->k = c.num_marcos;
+    alt->simetrico = c.simetrico != 0;
+    alt->ids = (int32_t *)((char *)alt->mapa + sizeof(c));
+    alt->marcos = alt->ids + c.n;
+    alt->de = (float *)((char *)alt->mapa + inicio_tabelas(c.n, c.num_marcos));
+    alt->para = alt->simetrico ? alt->de : alt->de + elementos;
+
+    if (alt->n != csr_num_vertices(csr))
+    {
+        fprintf(stderr, "carrega_alt: %s nao corresponde ao grafo\n", arquivo);
+        exit(EXIT_FAILURE);
+    }
+
+    for (v = 0; v < alt->n; v++)
+        if (alt->ids[v] != csr_id(csr, v))
+        {
+            fprintf(stderr, "carrega_alt: %s nao corresponde ao grafo\n", arquivo);
+            exit(EXIT_FAILURE);
+        }
+
+    for (v = 0; v < alt->k; v++)
+        if (alt->marcos[v] < 0 || alt->marcos[v] >= alt->n)
+        {
+            fprintf(stderr, "carrega_alt: arquivo invalido: %s\n", arquivo);
+            exit(EXIT_FAILURE);
+        }
+
+    return alt;
+}
+
+int alt_num_marcos(alt_t *alt)
+{
+    return alt->k;
+}
+
+int alt_marco(alt_t *alt, int i)
+{
+    if (alt == NULL || i < 0 || i >= alt->k)
+    {
+        fprintf(stderr, "alt_marco: marco invalido\n");
+        exit(EXIT_FAILURE);
+    }
+
+    return alt->marcos[i];
+}
+
+/* Maior limite entre todos os marcos. Uma distancia infinita so de um lado
+ * prova que nao ha caminho: se L alcanca u mas nao v, u tambem nao alcanca
+ * v; se v alcanca L mas u nao, u nao alcanca v */
+static float limite(const alt_t *alt, int u, int v)
+{
+    const float *de_u = alt->de + (size_t)u * alt->k, *de_v = alt->de + (size_t)v * alt->k;
+    const float *para_u = alt->para + (size_t)u * alt->k, *para_v = alt->para + (size_t)v * alt->k;
+    float h = 0;
+    int i;
+
+    for (i = 0; i < alt->k; i++)
+    {
+        if (de_u[i] != INFINITY)
+        {
+            if (de_v[i] == INFINITY)
+                return INFINITY;
+            if (de_v[i] - de_u[i] > h)
+                h = de_v[i] - de_u[i];
+        }
+
+        if (para_v[i] != INFINITY)
+        {
+            if (para_u[i] == INFINITY)
+                return INFINITY;
+            if (para_u[i] - para_v[i] > h)
+                h = para_u[i] - para_v[i];
+        }
+    }
+
+    return h;
+}
+
+float alt_limite(alt_t *alt, int u, int v)
+{
+    if (alt == NULL || u < 0 || v < 0 || u >= alt->n || v >= alt->n)
+    {
+        fprintf(stderr, "alt_limite: vertice invalido\n");
+        exit(EXIT_FAILURE);
+    }
+
+    return limite(alt, u, v);
+}
+
+/**
+  * @brief  A* guiado pelos marcos
+  * @param	alt: tabela de marcos do grafo
+  * @param  csr: grafo
+  * @param  fonte: índice de origem
+  * @param  destino: índice de destino
+  * @param  espaco: estado da consulta (reiniciado por esta função)
+  *
+  * A prioridade de cada vértice é dist + limite até o destino. O limite é
+  * consistente, logo cada vértice sai da fila uma única vez; vértices que
+  * os marcos provam não alcançar o destino nem entram na fila.
+  *
+  * @retval float: distância de fonte a destino (INFINITY se inalcançável)
+  */
+float alt_consulta(alt_t *alt, grafo_csr_t *csr, int fonte, int destino,
+                   espaco_busca_t *espaco)
+{
+    const int *offsets, *vizinhos;
+    const float *pesos;
+    fila_prioridade_t *fila;
+    float g, nova, h;
+    int k, u, w, n;
+
+    if (alt == NULL || csr == NULL || espaco == NULL || alt->n != csr_num_vertices(csr))
+    {
+        fprintf(stderr, "alt_consulta: parametros invalidos\n");
+        exit(EXIT_FAILURE);
+    }
+
+    n = csr_num_vertices(csr);
+    if (fonte < 0 || destino < 0 || fonte >= n || destino >= n ||
+        espaco_num_vertices(espaco) < n)
+    {
+        fprintf(stderr, "alt_consulta: vertice invalido\n");
+        exit(EXIT_FAILURE);
+    }
+
+    offsets = csr_offsets(csr);
+    vizinhos = csr_vizinhos(csr);
+    pesos = csr_pesos(csr);
+
+    espaco_reinicia(espaco);
+    fila = espaco_fila_prioridade(espaco);
+
+    h = limite(alt, fonte, destino);
+    if (h == INFINITY)
+        return INFINITY;
+
+    espaco_set_dist(espaco, fonte, 0);
+    fila_prioridade_inserir(fila, fonte, h);
+
+    while (!fila_prioridade_vazia(fila))
+    {
+        u = fila_prioridade_remover_min(fila, NULL);
+        espaco_visita(espaco, u);
+        if (u == destino)
+            break;
+
+        g = espaco_get_dist(espaco, u);
+        for (k = offsets[u]; k < offsets[u + 1]; k++)
+        {
+            w = vizinhos[k];
+            nova = g + pesos[k];
+            if (nova < espaco_get_dist(espaco, w))
+            {
+                h = limite(alt, w, destino);
+                if (h == INFINITY)
+                    continue;
+
+                espaco_set_dist(espaco, w, nova);
+                espaco_set_pai(espaco, w, u);
+                fila_prioridade_atualizar(fila, w, nova + h);
+            }
+        }
+    }
+
+    return espaco_get_dist(espaco, destino);
+}
+
+void libera_alt(alt_t *alt)
+{
+    if (alt == NULL)
+    {
+        fprintf(stderr, "libera_alt: tabela invalida\n");
+        exit(EXIT_FAILURE);
+    }
+
+    if (alt->mapa)
+        munmap(alt->mapa, alt->tamanho_mapa);
+    else
+    {
+        free(alt->ids);
+        free(alt->marcos);
+        free(alt->de);
+        if (!alt->simetrico)
+            free(alt->para);
+    }
+
+    free(alt);
+}
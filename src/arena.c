@@ -0,0 +1,194 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "arena.h"
+
+#define TAMANHO_BLOCO_PADRAO (64 * 1024)
+
+/* Alinhamento adequado a qualquer tipo */
+#define ALINHAMENTO (sizeof(max_align_t))
+#define ALINHA(n) (((n) + ALINHAMENTO - 1) & ~(ALINHAMENTO - 1))
+
+typedef struct bloco
+{
+    struct bloco *anterior;     /*!< Bloco alocado anteriormente */
+    max_align_t dados[];        /*!< Inicio da area util */
+} bloco_t;
+
+struct arenas
+{
+    bloco_t *atual;             /*!< Bloco em uso */
+    size_t usado;               /*!< Bytes ocupados no bloco atual */
+    size_t capacidade;          /*!< Bytes uteis do bloco atual */
+    size_t tamanho_bloco;       /*!< Tamanho padrao dos novos blocos */
+};
+
+struct pools
+{
+    arena_t *arena;
+    size_t tamanho_objeto;
+    int objetos_por_slab;
+    char *slab;                 /*!< Proximo objeto nunca usado do slab atual */
+    int restantes;              /*!< Objetos nunca usados no slab atual */
+};
+
+/**
+  * @brief  Cria uma arena vazia
+  * @param	tamanho_bloco: bytes por bloco. 0 para o tamanho padrão
+  *
+  * @retval arena_t: ponteiro para a nova arena
+  */
+arena_t *cria_arena(size_t tamanho_bloco)
+{
+    arena_t *p = malloc(sizeof(arena_t));
+
+    if (p == NULL)
+    {
+        perror("cria_arena:");
+        exit(EXIT_FAILURE);
+    }
+
+    p->atual = NULL;
+    p->usado = 0;
+    p->capacidade = 0;
+    p->tamanho_bloco = tamanho_bloco ? ALINHA(tamanho_bloco) : TAMANHO_BLOCO_PADRAO;
+
+    return p;
+}
+
+/**
+  * @brief  Aloca memória da arena
+  * @param	arena: arena
+  * @param  tamanho: número de bytes
+  *
+  * Pedidos maiores que o bloco padrão recebem um bloco exclusivo.
+  *
+  * @retval void*: memória alinhada, válida até libera_arena
+  */
+void *arena_aloca(arena_t *arena, size_t tamanho)
+{
+    bloco_t *bloco;
+    size_t capacidade;
+    void *p;
+
+    if (arena == NULL)
+    {
+        fprintf(stderr, "arena_aloca: arena invalida\n");
+        exit(EXIT_FAILURE);
+    }
+
+    tamanho = ALINHA(tamanho > 0 ? tamanho : 1);
+
+    if (arena->atual == NULL || arena->usado + tamanho > arena->capacidade)
+    {
+        capacidade = tamanho > arena->tamanho_bloco ? tamanho : arena->tamanho_bloco;
+
+        bloco = malloc(sizeof(bloco_t) + capacidade);
+        if (bloco == NULL)
+        {
+            perror("arena_aloca:");
+            exit(EXIT_FAILURE);
+        }
+
+        bloco->anterior = arena->atual;
+        arena->atual = bloco;
+        arena->usado = 0;
+        arena->capacidade = capacidade;
+    }
+
+    p = (char*) arena->atual->dados + arena->usado;
+    arena->usado += tamanho;
+
+    return p;
+}
+
+char *arena_copia_string(arena_t *arena, const char *texto)
+{
+    char *copia;
+
+    if (texto == NULL)
+        return NULL;
+
+    copia = arena_aloca(arena, strlen(texto) + 1);
+    strcpy(copia, texto);
+
+    return copia;
+}
+
+/**
+  * @brief  Libera a arena e tudo que foi alocado nela
+  * @param	arena: arena
+  *
+  * @retval Nenhum
+  */
+void libera_arena(arena_t *arena)
+{
+    bloco_t *bloco, *anterior;
+
+    if (arena == NULL)
+    {
+        fprintf(stderr, "libera_arena: arena invalida\n");
+        exit(EXIT_FAILURE);
+    }
+
+    for (bloco = arena->atual; bloco; bloco = anterior)
+    {
+        anterior = bloco->anterior;
+        free(bloco);
+    }
+
+    free(arena);
+}
+
+/**
+  * @brief  Cria um pool de objetos de tamanho fixo
+  * @param	arena: arena que fornece os slabs
+  * @param  tamanho_objeto: tamanho de cada objeto
+  * @param  objetos_por_slab: objetos alocados de uma vez
+  *
+  * @retval pool_t: ponteiro para o novo pool, liberado junto com a arena
+  */
+pool_t *cria_pool(arena_t *arena, size_t tamanho_objeto, int objetos_por_slab)
+{
+    pool_t *p;
+
+    if (arena == NULL || tamanho_objeto == 0 || objetos_por_slab <= 0)
+    {
+        fprintf(stderr, "cria_pool: parametros invalidos\n");
+        exit(EXIT_FAILURE);
+    }
+
+    p = arena_aloca(arena, sizeof(pool_t));
+    p->arena = arena;
+    /* Objetos alinhados a ponteiro: suficiente para as estruturas do grafo */
+    p->tamanho_objeto = (tamanho_objeto + sizeof(void*) - 1) & ~(sizeof(void*) - 1);
+    p->objetos_por_slab = objetos_por_slab;
+    p->slab = NULL;
+    p->restantes = 0;
+
+    return p;
+}
+
+void *pool_aloca(pool_t *pool)
+{
+    void *objeto;
+
+    if (pool == NULL)
+    {
+        fprintf(stderr, "pool_aloca: pool invalido\n");
+        exit(EXIT_FAILURE);
+    }
+
+    if (pool->restantes == 0)
+    {
+        pool->slab = arena_aloca(pool->arena, pool->tamanho_objeto * pool->objetos_por_slab);
+        pool->restantes = pool->objetos_por_slab;
+    }
+
+    objeto = pool->slab;
+    pool->slab += pool->tamanho_objeto;
+    pool->restantes--;
+
+    return objeto;
+}
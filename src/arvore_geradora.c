@@ -0,0 +1,656 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "arvore_geradora.h"
+#include "conjunto_disjunto.h"
+#include "paralelo.h"
+#include "espaco_busca.h"
+#include "componentes.h"
+
+#define FALSE 0
+#define TRUE 1
+
+/* Subproblemas do filter-Kruskal ate este tamanho sao ordenados direto */
+#define FILTRO_LIMIAR 1024
+
+/* Arestas ou vertices por tarefa nas rodadas de Boruvka */
+#define BORUVKA_BLOCO 4096
+#define BORUVKA_NENHUMA UINT64_MAX
+
+/* Aresta nao direcionada u < v, na ordem (peso, u, v) */
+typedef struct aresta_ordenada
+{
+    float peso;
+    int u;
+    int v;
+    arestas_t *aresta;          /*!< Aresta de u para v no grafo de origem */
+} aresta_ordenada_t;
+
+/* Ordem total: o resultado nao depende do algoritmo de ordenacao nem do
+ * numero de threads */
+static int compara_arestas(const void *a, const void *b)
+{
+    const aresta_ordenada_t *x = a, *y = b;
+
+    if (x->peso != y->peso)
+        return x->peso < y->peso ? -1 : 1;
+    if (x->u != y->u)
+        return x->u < y->u ? -1 : 1;
+    return (x->v > y->v) - (x->v < y->v);
+}
+
+static int compara_destino(const void *a, const void *b)
+{
+    const aresta_ordenada_t *x = a, *y = b;
+
+    return (x->v > y->v) - (x->v < y->v);
+}
+
+/**
+  * @brief  Chave de desempate de (u, v) na ordem de compara_arestas
+  * @param  u, v: indices das pontas, em qualquer ordem
+  *
+  * @retval uint64_t: menor indice nos 32 bits altos, maior nos baixos
+  */
+uint64_t desempate_aresta(int u, int v)
+{
+    if (u > v)
+        return ((uint64_t)v << 32) | (uint32_t)u;
+
+    return ((uint64_t)u << 32) | (uint32_t)v;
+}
+
+/* Copia cada aresta nao direcionada uma vez (do menor para o maior indice).
+ * O vetor sai em ordem de (u, v), de modo que a posicao desempata arestas
+ * de mesmo peso exatamente como compara_arestas */
+static aresta_ordenada_t *extrai_arestas(grafo_t *grafo, int *m)
+{
+    aresta_ordenada_t *arestas;
+    arestas_t *aresta;
+    no_t *no;
+    int n, u, v, k = 0, inicio;
+
+    n = numero_vertices(grafo);
+
+    for (u = 0; u < n; u++)
+        for (no = obter_cabeca(vertice_get_arestas(grafo_get_vertice(grafo, u)));
+             no; no = obtem_proximo(no))
+            if (vertice_get_indice(aresta_get_adjacente(obter_dado(no))) > u)
+                k++;
+
+    arestas = malloc((k > 0 ? k : 1) * sizeof(aresta_ordenada_t));
+    if (arestas == NULL)
+    {
+        perror("kruskal_algorithm:");
+        exit(EXIT_FAILURE);
+    }
+
+    *m = k;
+    k = 0;
+
+    for (u = 0; u < n; u++)
+    {
+        inicio = k;
+        for (no = obter_cabeca(vertice_get_arestas(grafo_get_vertice(grafo, u)));
+             no; no = obtem_proximo(no))
+        {
+            aresta = obter_dado(no);
+            v = vertice_get_indice(aresta_get_adjacente(aresta));
+            if (v > u)
+            {
+                arestas[k].peso = aresta_get_peso(aresta);
+                arestas[k].u = u;
+                arestas[k].v = v;
+                arestas[k].aresta = aresta;
+                k++;
+            }
+        }
+        qsort(arestas + inicio, k - inicio, sizeof(aresta_ordenada_t), compara_destino);
+    }
+
+    return arestas;
+}
+
+/* Percorre arestas ja ordenadas. Retorna quantas arestas ainda faltam */
+static int une_arestas(aresta_ordenada_t *arestas, int m, conjunto_disjunto_t *conjuntos,
+                       grafo_t *arvore, int faltam)
+{
+    int i;
+
+    for (i = 0; i < m && faltam > 0; i++)
+        if (conjunto_unir(conjuntos, arestas[i].u, arestas[i].v))
+        {
+            adiciona_aresta_grafo(arvore, arestas[i].aresta);
+            faltam--;
+        }
+
+    return faltam;
+}
+
+static void troca(aresta_ordenada_t *a, aresta_ordenada_t *b)
+{
+    aresta_ordenada_t t = *a;
+
+    *a = *b;
+    *b = t;
+}
+
+/* Mediana entre primeira, do meio e ultima aresta */
+static aresta_ordenada_t escolhe_pivo(aresta_ordenada_t *arestas, int m)
+{
+    aresta_ordenada_t a = arestas[0], b = arestas[m / 2], c = arestas[m - 1];
+
+    if (compara_arestas(&a, &b) > 0)
+        troca(&a, &b);
+    if (compara_arestas(&b, &c) > 0)
+        troca(&b, &c);
+    if (compara_arestas(&a, &b) > 0)
+        troca(&a, &b);
+
+    return b;
+}
+
+/**
+  * @brief  Filter-Kruskal
+  * @param	arestas: arestas do subproblema, reordenadas no lugar
+  * @param  m: número de arestas
+  * @param  conjuntos: componentes da floresta construída até agora
+  * @param  arvore: grafo que recebe as arestas escolhidas
+  * @param  faltam: arestas que ainda faltam para completar a floresta
+  *
+  * Como no quicksort, as arestas são divididas pelo pivô. As leves são
+  * processadas primeiro; das pesadas, as que ligam vértices já conectados
+  * são descartadas antes de qualquer ordenação.
+  *
+  * @retval int: arestas que ainda faltam
+  */
+static int filtro_kruskal(aresta_ordenada_t *arestas, int m, conjunto_disjunto_t *conjuntos,
+                          grafo_t *arvore, int faltam)
+{
+    aresta_ordenada_t pivo;
+    int leves = 0, k, j;
+
+    if (faltam == 0 || m == 0)
+        return faltam;
+
+    if (m > FILTRO_LIMIAR)
+    {
+        pivo = escolhe_pivo(arestas, m);
+        for (j = 0; j < m; j++)
+            if (compara_arestas(&arestas[j], &pivo) < 0)
+                troca(&arestas[leves++], &arestas[j]);
+    }
+
+    /* Subproblema pequeno ou pivo no extremo: ordena tudo */
+    if (leves == 0)
+    {
+        qsort(arestas, m, sizeof(aresta_ordenada_t), compara_arestas);
+        return une_arestas(arestas, m, conjuntos, arvore, faltam);
+    }
+
+    faltam = filtro_kruskal(arestas, leves, conjuntos, arvore, faltam);
+    if (faltam == 0)
+        return 0;
+
+    k = leves;
+    for (j = leves; j < m; j++)
+        if (conjunto_encontrar(conjuntos, arestas[j].u) !=
+            conjunto_encontrar(conjuntos, arestas[j].v))
+            arestas[k++] = arestas[j];
+
+    return filtro_kruskal(arestas + leves, k - leves, conjuntos, arvore, faltam);
+}
+
+/**
+  * @brief  Árvore (floresta) geradora mínima pelo algoritmo de Kruskal
+  * @param	grafo: grafo não direcionado
+  * @param  modo: KRUSKAL_ORDENACAO ou KRUSKAL_FILTRO
+  * @param  num_threads: threads da ordenação (0: uma por núcleo)
+  *
+  * @retval grafo_t: novo grafo contendo apenas as arestas da árvore
+  */
+grafo_t *kruskal_algorithm_modo(grafo_t *grafo, modo_kruskal_t modo, int num_threads)
+{
+    aresta_ordenada_t *arestas;
+    conjunto_disjunto_t *conjuntos;
+    grafo_t *arvore;
+    int n, m;
+
+    if (grafo == NULL || num_threads < 0)
+    {
+        fprintf(stderr, "kruskal_algorithm: parametros invalidos\n");
+        exit(EXIT_FAILURE);
+    }
+
+    n = numero_vertices(grafo);
+    arestas = extrai_arestas(grafo, &m);
+    conjuntos = cria_conjunto_disjunto(n);
+    arvore = cria_grafo(0);
+
+    switch (modo)
+    {
+    case KRUSKAL_ORDENACAO:
+        paralelo_ordena(arestas, m, sizeof(aresta_ordenada_t), compara_arestas, num_threads);
+        une_arestas(arestas, m, conjuntos, arvore, n - 1);
+        break;
+    case KRUSKAL_FILTRO:
+        filtro_kruskal(arestas, m, conjuntos, arvore, n - 1);
+        break;
+    default:
+        fprintf(stderr, "kruskal_algorithm: modo invalido\n");
+        exit(EXIT_FAILURE);
+    }
+
+    libera_conjunto_disjunto(conjuntos);
+    free(arestas);
+
+    return arvore;
+}
+
+grafo_t *kruskal_algorithm(grafo_t *grafo)
+{
+    return kruskal_algorithm_modo(grafo, KRUSKAL_ORDENACAO, 0);
+}
+
+/* Estado compartilhado pelas tarefas de uma execucao de Boruvka */
+typedef struct boruvka
+{
+    aresta_ordenada_t *arestas;
+    int m;
+    int n;
+    int *vivas;                 /*!< Arestas entre componentes distintos, por bloco */
+    int *componente;            /*!< Representante de cada vertice na rodada */
+    uint64_t *melhor;           /*!< Menor chave saindo de cada componente */
+    conjunto_disjunto_t *conjuntos;
+    aresta_ordenada_t *escolhidas;
+    int num_escolhidas;
+    int uniu;                   /*!< A rodada uniu algum componente */
+} boruvka_t;
+
+/* Chave de 64 bits com a ordem de (peso, posicao): os bits do float sao
+ * transformados para que a comparacao de inteiros sem sinal siga a dos
+ * pesos, inclusive negativos */
+static uint64_t chave_aresta(float peso, int posicao)
+{
+    uint32_t bits;
+
+    memcpy(&bits, &peso, sizeof(bits));
+    bits = (bits & 0x80000000u) ? ~bits : bits | 0x80000000u;
+
+    return ((uint64_t)bits << 32) | (uint32_t)posicao;
+}
+
+static void minimo_atomico(uint64_t *destino, uint64_t valor)
+{
+    uint64_t atual = __atomic_load_n(destino, __ATOMIC_RELAXED);
+
+    while (valor < atual &&
+           !__atomic_compare_exchange_n(destino, &atual, valor, TRUE,
+                                        __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+        ;
+}
+
+static void boruvka_limpa(void *contexto, int i)
+{
+    boruvka_t *b = contexto;
+    int v, fim = (i + 1) * BORUVKA_BLOCO < b->n ? (i + 1) * BORUVKA_BLOCO : b->n;
+
+    for (v = i * BORUVKA_BLOCO; v < fim; v++)
+        b->melhor[v] = BORUVKA_NENHUMA;
+}
+
+/* Descarta arestas internas do bloco e oferece as demais aos dois
+ * componentes das pontas. A compactacao preserva a ordem relativa, entao
+ * a posicao continua desempatando na ordem de (u, v) */
+static void boruvka_menor_aresta(void *contexto, int i)
+{
+    boruvka_t *b = contexto;
+    aresta_ordenada_t *bloco = b->arestas + i * BORUVKA_BLOCO;
+    int j, k = 0, cu, cv, posicao;
+    uint64_t chave;
+
+    for (j = 0; j < b->vivas[i]; j++)
+    {
+        cu = b->componente[bloco[j].u];
+        cv = b->componente[bloco[j].v];
+        if (cu == cv)
+            continue;
+
+        bloco[k] = bloco[j];
+        posicao = i * BORUVKA_BLOCO + k;
+        k++;
+
+        chave = chave_aresta(bloco[j].peso, posicao);
+        minimo_atomico(&b->melhor[cu], chave);
+        minimo_atomico(&b->melhor[cv], chave);
+    }
+
+    b->vivas[i] = k;
+}
+
+static void boruvka_une(void *contexto, int i)
+{
+    boruvka_t *b = contexto;
+    aresta_ordenada_t *aresta;
+    int c, k, fim = (i + 1) * BORUVKA_BLOCO < b->n ? (i + 1) * BORUVKA_BLOCO : b->n;
+
+    for (c = i * BORUVKA_BLOCO; c < fim; c++)
+    {
+        if (b->componente[c] != c || b->melhor[c] == BORUVKA_NENHUMA)
+            continue;
+
+        aresta = &b->arestas[b->melhor[c] & 0xffffffffu];
+
+        /* Dois componentes podem escolher a mesma aresta: so um a une */
+        if (conjunto_unir_concorrente(b->conjuntos, aresta->u, aresta->v))
+        {
+            k = __atomic_fetch_add(&b->num_escolhidas, 1, __ATOMIC_RELAXED);
+            b->escolhidas[k] = *aresta;
+            __atomic_store_n(&b->uniu, TRUE, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+static void boruvka_rotula(void *contexto, int i)
+{
+    boruvka_t *b = contexto;
+    int v, fim = (i + 1) * BORUVKA_BLOCO < b->n ? (i + 1) * BORUVKA_BLOCO : b->n;
+
+    for (v = i * BORUVKA_BLOCO; v < fim; v++)
+        b->componente[v] = conjunto_encontrar_concorrente(b->conjuntos, v);
+}
+
+/**
+  * @brief  Árvore (floresta) geradora mínima pelo algoritmo de Borůvka
+  * @param	grafo: grafo não direcionado
+  * @param  num_threads: número de threads (0: uma por núcleo)
+  *
+  * Em cada rodada, em paralelo: cada componente escolhe a aresta mais leve
+  * que o deixa (mínimo atômico sobre a chave (peso, u, v)) e as escolhidas
+  * são contraídas com o union-find concorrente. O número de componentes ao
+  * menos cai pela metade por rodada. Com a mesma ordem total de Kruskal, a
+  * árvore é única e igual à de kruskal_algorithm.
+  *
+  * @retval grafo_t: novo grafo contendo apenas as arestas da árvore
+  */
+grafo_t *boruvka_algorithm_threads(grafo_t *grafo, int num_threads)
+{
+    boruvka_t b;
+    grafo_t *arvore;
+    int i, blocos_arestas, blocos_vertices;
+
+    if (grafo == NULL || num_threads < 0)
+    {
+        fprintf(stderr, "boruvka_algorithm: parametros invalidos\n");
+        exit(EXIT_FAILURE);
+    }
+
+    b.n = numero_vertices(grafo);
+    b.arestas = extrai_arestas(grafo, &b.m);
+    b.conjuntos = cria_conjunto_disjunto(b.n);
+    b.num_escolhidas = 0;
+
+    blocos_arestas = (b.m + BORUVKA_BLOCO - 1) / BORUVKA_BLOCO;
+    blocos_vertices = (b.n + BORUVKA_BLOCO - 1) / BORUVKA_BLOCO;
+
+    b.vivas = malloc((blocos_arestas > 0 ? blocos_arestas : 1) * sizeof(int));
+    b.componente = malloc((b.n > 0 ? b.n : 1) * sizeof(int));
+    b.melhor = malloc((b.n > 0 ? b.n : 1) * sizeof(uint64_t));
+    b.escolhidas = malloc((b.n > 0 ? b.n : 1) * sizeof(aresta_ordenada_t));
+
+    if (b.vivas == NULL || b.componente == NULL || b.melhor == NULL || b.escolhidas == NULL)
+    {
+        perror("boruvka_algorithm:");
+        exit(EXIT_FAILURE);
+    }
+
+    for (i = 0; i < blocos_arestas; i++)
+        b.vivas[i] = (i + 1) * BORUVKA_BLOCO < b.m ? BORUVKA_BLOCO : b.m - i * BORUVKA_BLOCO;
+    for (i = 0; i < b.n; i++)
+        b.componente[i] = i;
+
+    do
+    {
+        b.uniu = FALSE;
+        paralelo_executa(num_threads, blocos_vertices, boruvka_limpa, &b);
+        paralelo_executa(num_threads, blocos_arestas, boruvka_menor_aresta, &b);
+        paralelo_executa(num_threads, blocos_vertices, boruvka_une, &b);
+        paralelo_executa(num_threads, blocos_vertices, boruvka_rotula, &b);
+    } while (b.uniu);
+
+    /* A ordem de chegada depende das threads: ordena antes de montar */
+    qsort(b.escolhidas, b.num_escolhidas, sizeof(aresta_ordenada_t), compara_arestas);
+
+    arvore = cria_grafo(0);
+    for (i = 0; i < b.num_escolhidas; i++)
+        adiciona_aresta_grafo(arvore, b.escolhidas[i].aresta);
+
+    libera_conjunto_disjunto(b.conjuntos);
+    free(b.arestas);
+    free(b.vivas);
+    free(b.componente);
+    free(b.melhor);
+    free(b.escolhidas);
+
+    return arvore;
+}
+
+grafo_t *boruvka_algorithm(grafo_t *grafo)
+{
+    return boruvka_algorithm_threads(grafo, 0);
+}
+
+/* Estado compartilhado pelas threads da floresta geradora */
+typedef struct floresta_trabalho
+{
+    grafo_t *grafo;
+    floresta_t *floresta;
+    int *ordem;                 /*!< Componentes do maior para o menor */
+    int *raiz_indice;           /*!< Indice do vertice raiz de cada componente */
+    arestas_t **escolhida;      /*!< Aresta que liga cada vertice a arvore */
+    int proximo;                /*!< Proxima posicao de ordem a processar */
+} floresta_trabalho_t;
+
+/* Prim restrito ao componente da raiz. Componentes distintos tocam vertices
+ * distintos, entao varias chamadas podem escrever em escolhida ao mesmo
+ * tempo */
+static float prim_componente(grafo_t *grafo, int raiz, espaco_busca_t *espaco,
+                             arestas_t **escolhida)
+{
+    fila_prioridade_t *fila;
+    arestas_t *aresta;
+    no_t *no;
+    float custo, total = 0;
+    int u, w;
+
+    espaco_reinicia(espaco);
+    fila = espaco_fila_prioridade(espaco);
+    fila_prioridade_inserir(fila, raiz, 0);
+
+    while (!fila_prioridade_vazia(fila))
+    {
+        u = fila_prioridade_remover_min(fila, &custo);
+        espaco_visita(espaco, u);
+        escolhida[u] = espaco_get_aresta(espaco, u);
+        total += custo;
+
+        for (no = obter_cabeca(vertice_get_arestas(grafo_get_vertice(grafo, u)));
+             no; no = obtem_proximo(no))
+        {
+            aresta = obter_dado(no);
+            w = vertice_get_indice(aresta_get_adjacente(aresta));
+
+            if (!espaco_visitado(espaco, w) &&
+                fila_prioridade_atualizar_desempate(fila, w, aresta_get_peso(aresta),
+                                                    desempate_aresta(u, w)))
+                espaco_set_aresta(espaco, w, aresta);
+        }
+    }
+
+    return total;
+}
+
+/* Uma tarefa por thread: retira componentes da lista ate esvazia-la */
+static void floresta_trabalha(void *contexto, int i)
+{
+    floresta_trabalho_t *t = contexto;
+    floresta_t *f = t->floresta;
+    espaco_busca_t *espaco;
+    int k, c;
+
+    (void)i;
+    espaco = cria_espaco_busca(numero_vertices(t->grafo), HEAP_DARIO);
+
+    for (;;)
+    {
+        k = __atomic_fetch_add(&t->proximo, 1, __ATOMIC_RELAXED);
+        if (k >= f->num_componentes)
+            break;
+
+        c = t->ordem[k];
+        f->totais[c] = f->tamanhos[c] > 1 ?
+            prim_componente(t->grafo, t->raiz_indice[c], espaco, t->escolhida) : 0;
+    }
+
+    libera_espaco_busca(espaco);
+}
+
+typedef struct componente_tamanho
+{
+    int tamanho;
+    int componente;
+} componente_tamanho_t;
+
+/* Maiores primeiro */
+static int compara_tamanho(const void *a, const void *b)
+{
+    const componente_tamanho_t *x = a, *y = b;
+
+    if (x->tamanho != y->tamanho)
+        return x->tamanho > y->tamanho ? -1 : 1;
+    return x->componente - y->componente;
+}
+
+/**
+  * @brief  Floresta geradora mínima, um Prim por componente em paralelo
+  * @param	grafo: grafo não direcionado
+  * @param  num_threads: número de threads (0: uma por núcleo)
+  *
+  * Os componentes são distribuídos sob demanda do maior para o menor, para
+  * que o maior não fique por último. Componentes de um só vértice não
+  * executam Prim.
+  *
+  * @retval floresta_t: floresta e totais por componente
+  */
+floresta_t *floresta_geradora_minima(grafo_t *grafo, int num_threads)
+{
+    floresta_trabalho_t t;
+    componente_tamanho_t *ordem;
+    componentes_t *componentes;
+    floresta_t *f;
+    vertice_t *v, *copia;
+    int n, i, k, c;
+
+    if (grafo == NULL || num_threads < 0)
+    {
+        fprintf(stderr, "floresta_geradora_minima: parametros invalidos\n");
+        exit(EXIT_FAILURE);
+    }
+
+    n = numero_vertices(grafo);
+    f = malloc(sizeof(floresta_t));
+    if (f == NULL)
+    {
+        perror("floresta_geradora_minima:");
+        exit(EXIT_FAILURE);
+    }
+
+    componentes = componentes_conexos(grafo);
+    k = componentes_num(componentes);
+
+    f->num_componentes = k;
+    f->totais = malloc((k > 0 ? k : 1) * sizeof(float));
+    f->tamanhos = malloc((k > 0 ? k : 1) * sizeof(int));
+    f->raizes = malloc((k > 0 ? k : 1) * sizeof(int));
+
+    t.grafo = grafo;
+    t.floresta = f;
+    t.proximo = 0;
+    t.ordem = malloc((k > 0 ? k : 1) * sizeof(int));
+    t.raiz_indice = malloc((k > 0 ? k : 1) * sizeof(int));
+    t.escolhida = calloc(n > 0 ? n : 1, sizeof(arestas_t*));
+
+    if (f->totais == NULL || f->tamanhos == NULL || f->raizes == NULL ||
+        t.ordem == NULL || t.raiz_indice == NULL || t.escolhida == NULL)
+    {
+        perror("floresta_geradora_minima:");
+        exit(EXIT_FAILURE);
+    }
+
+    /* Vertices de cada componente em ordem crescente: o primeiro e a raiz */
+    for (c = 0; c < k; c++)
+    {
+        f->tamanhos[c] = componentes_tamanho(componentes, c);
+        t.raiz_indice[c] = componentes_vertices(componentes, c)[0];
+        f->raizes[c] = vertice_get_id(grafo_get_vertice(grafo, t.raiz_indice[c]));
+    }
+
+    ordem = malloc((k > 0 ? k : 1) * sizeof(componente_tamanho_t));
+    if (ordem == NULL)
+    {
+        perror("floresta_geradora_minima:");
+        exit(EXIT_FAILURE);
+    }
+
+    for (c = 0; c < k; c++)
+    {
+        ordem[c].tamanho = f->tamanhos[c];
+        ordem[c].componente = c;
+    }
+    qsort(ordem, k, sizeof(componente_tamanho_t), compara_tamanho);
+    for (c = 0; c < k; c++)
+        t.ordem[c] = ordem[c].componente;
+    free(ordem);
+
+    if (num_threads == 0)
+        num_threads = paralelo_num_threads();
+    paralelo_executa(num_threads, num_threads < k ? num_threads : k, floresta_trabalha, &t);
+
+    /* Montagem sequencial: grafo_t nao aceita insercoes simultaneas */
+    f->arvores = cria_grafo(0);
+    for (i = 0; i < n; i++)
+    {
+        v = grafo_get_vertice(grafo, i);
+        copia = grafo_adicionar_vertice(f->arvores, vertice_get_id(v));
+        grafo_set_nome(f->arvores, copia, vertice_get_nome(v));
+        vertice_set_grupo(copia, componentes_rotulo(componentes, i));
+    }
+    libera_componentes(componentes);
+
+    for (i = 0; i < n; i++)
+        if (t.escolhida[i])
+            adiciona_aresta_grafo(f->arvores, t.escolhida[i]);
+
+    free(t.ordem);
+    free(t.raiz_indice);
+    free(t.escolhida);
+
+    return f;
+}
+
+void libera_floresta(floresta_t *floresta)
+{
+    if (floresta == NULL)
+    {
+        fprintf(stderr, "libera_floresta: floresta invalida\n");
+        exit(EXIT_FAILURE);
+    }
+
+    libera_grafo(floresta->arvores);
+    free(floresta->totais);
+    free(floresta->tamanhos);
+    free(floresta->raizes);
+    free(floresta);
+}
@@ -0,0 +1,266 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "componentes.h"
+#include "conjunto_disjunto.h"
+#include "paralelo.h"
+
+#define FALSE 0
+#define TRUE 1
+
+/* Vertices por tarefa na propagacao de rotulos */
+#define PROPAGACAO_BLOCO 4096
+
+struct componentes
+{
+    int n;
+    int num;
+    int *rotulo;        /*!< Componente de cada vertice */
+    int *offsets;       /*!< num + 1 posicoes: inicio de cada componente em vertices */
+    int *vertices;      /*!< Vertices agrupados por componente */
+};
+
+static void *aloca(size_t tamanho)
+{
+    void *p = malloc(tamanho > 0 ? tamanho : 1);
+
+    if (p == NULL)
+    {
+        perror("componentes_conexos:");
+        exit(EXIT_FAILURE);
+    }
+
+    return p;
+}
+
+/* Rotulo provisorio de cada vertice: o union-find deixa um representante
+ * qualquer do componente */
+static void rotula_uniao(grafo_t *grafo, int *rotulo)
+{
+    conjunto_disjunto_t *conjuntos;
+    int n, u;
+    no_t *no;
+
+    n = numero_vertices(grafo);
+    conjuntos = cria_conjunto_disjunto(n);
+
+    for (u = 0; u < n; u++)
+        for (no = obter_cabeca(vertice_get_arestas(grafo_get_vertice(grafo, u)));
+             no; no = obtem_proximo(no))
+            conjunto_unir(conjuntos, u, vertice_get_indice(aresta_get_adjacente(obter_dado(no))));
+
+    for (u = 0; u < n; u++)
+        rotulo[u] = conjunto_encontrar(conjuntos, u);
+
+    libera_conjunto_disjunto(conjuntos);
+}
+
+typedef struct propagacao
+{
+    grafo_t *grafo;
+    int n;
+    int *rotulo;
+    int mudou;
+} propagacao_t;
+
+/* Cada vertice adota o menor rotulo entre o seu, o dos vizinhos e o do
+ * vertice que o rotulo aponta (atalho). Leituras e escritas concorrentes
+ * sao atomicas; como os rotulos so diminuem, a ordem entre threads nao
+ * altera o ponto fixo, apenas o numero de rodadas */
+static void propaga_bloco(void *contexto, int i)
+{
+    propagacao_t *p = contexto;
+    int v, w, menor, r, fim;
+    no_t *no;
+
+    fim = (i + 1) * PROPAGACAO_BLOCO < p->n ? (i + 1) * PROPAGACAO_BLOCO : p->n;
+
+    for (v = i * PROPAGACAO_BLOCO; v < fim; v++)
+    {
+        menor = __atomic_load_n(&p->rotulo[v], __ATOMIC_RELAXED);
+
+        r = __atomic_load_n(&p->rotulo[menor], __ATOMIC_RELAXED);
+        if (r < menor)
+            menor = r;
+
+        for (no = obter_cabeca(vertice_get_arestas(grafo_get_vertice(p->grafo, v)));
+             no; no = obtem_proximo(no))
+        {
+            w = vertice_get_indice(aresta_get_adjacente(obter_dado(no)));
+            r = __atomic_load_n(&p->rotulo[w], __ATOMIC_RELAXED);
+            if (r < menor)
+                menor = r;
+        }
+
+        if (menor < __atomic_load_n(&p->rotulo[v], __ATOMIC_RELAXED))
+        {
+            __atomic_store_n(&p->rotulo[v], menor, __ATOMIC_RELAXED);
+            __atomic_store_n(&p->mudou, TRUE, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+/* Ao final, o rotulo de cada vertice e o menor indice do seu componente */
+static void rotula_propagacao(grafo_t *grafo, int *rotulo, int num_threads)
+{
+    propagacao_t p;
+    int v, blocos;
+
+    p.grafo = grafo;
+    p.n = numero_vertices(grafo);
+    p.rotulo = rotulo;
+    blocos = (p.n + PROPAGACAO_BLOCO - 1) / PROPAGACAO_BLOCO;
+
+    for (v = 0; v < p.n; v++)
+        rotulo[v] = v;
+
+    do
+    {
+        p.mudou = FALSE;
+        paralelo_executa(num_threads, blocos, propaga_bloco, &p);
+    } while (p.mudou);
+}
+
+/**
+  * @brief  Calcula os componentes conexos
+  * @param	grafo: grafo não direcionado
+  * @param  metodo: COMPONENTES_UNIAO ou COMPONENTES_PROPAGACAO
+  * @param  num_threads: threads da propagação (0: uma por núcleo)
+  *
+  * Os rótulos provisórios de cada método são renumerados na ordem do menor
+  * índice e os vértices agrupados por componente com contagem, em O(V + E).
+  *
+  * @retval componentes_t: rótulos, tamanhos e vértices de cada componente
+  */
+componentes_t *componentes_conexos_metodo(grafo_t *grafo, metodo_componentes_t metodo,
+                                          int num_threads)
+{
+    componentes_t *c;
+    int *novo, *posicao, n, v, r;
+
+    if (grafo == NULL || num_threads < 0)
+    {
+        fprintf(stderr, "componentes_conexos: parametros invalidos\n");
+        exit(EXIT_FAILURE);
+    }
+
+    n = numero_vertices(grafo);
+    c = aloca(sizeof(componentes_t));
+    c->n = n;
+    c->rotulo = aloca(n * sizeof(int));
+    c->vertices = aloca(n * sizeof(int));
+
+    switch (metodo)
+    {
+    case COMPONENTES_UNIAO:
+        rotula_uniao(grafo, c->rotulo);
+        break;
+    case COMPONENTES_PROPAGACAO:
+        rotula_propagacao(grafo, c->rotulo, num_threads);
+        break;
+    default:
+        fprintf(stderr, "componentes_conexos: metodo invalido\n");
+        exit(EXIT_FAILURE);
+    }
+
+    /* Renumera: o primeiro vertice de cada rotulo provisorio abre um
+     * componente. Rotulos provisorios sao indices de vertice */
+    novo = aloca(n * sizeof(int));
+    for (v = 0; v < n; v++)
+        novo[v] = -1;
+
+    c->num = 0;
+    for (v = 0; v < n; v++)
+    {
+        r = c->rotulo[v];
+        if (novo[r] == -1)
+            novo[r] = c->num++;
+        c->rotulo[v] = novo[r];
+        vertice_set_grupo(grafo_get_vertice(grafo, v), c->rotulo[v]);
+    }
+
+    /* Contagem: offsets[k + 1] acumula o tamanho do componente k */
+    c->offsets = calloc(c->num + 1, sizeof(int));
+    if (c->offsets == NULL)
+    {
+        perror("componentes_conexos:");
+        exit(EXIT_FAILURE);
+    }
+
+    for (v = 0; v < n; v++)
+        c->offsets[c->rotulo[v] + 1]++;
+    for (r = 0; r < c->num; r++)
+        c->offsets[r + 1] += c->offsets[r];
+
+    posicao = novo;
+    for (r = 0; r < c->num; r++)
+        posicao[r] = c->offsets[r];
+    for (v = 0; v < n; v++)
+        c->vertices[posicao[c->rotulo[v]]++] = v;
+
+    free(novo);
+
+    return c;
+}
+
+componentes_t *componentes_conexos(grafo_t *grafo)
+{
+    return componentes_conexos_metodo(grafo, COMPONENTES_UNIAO, 0);
+}
+
+int componentes_num(componentes_t *componentes)
+{
+    return componentes->num;
+}
+
+int componentes_rotulo(componentes_t *componentes, int v)
+{
+    if (componentes == NULL || v < 0 || v >= componentes->n)
+    {
+        fprintf(stderr, "componentes_rotulo: vertice invalido\n");
+        exit(EXIT_FAILURE);
+    }
+
+    return componentes->rotulo[v];
+}
+
+int componentes_alcancavel(componentes_t *componentes, int u, int v)
+{
+    return componentes_rotulo(componentes, u) == componentes_rotulo(componentes, v);
+}
+
+int componentes_tamanho(componentes_t *componentes, int c)
+{
+    if (componentes == NULL || c < 0 || c >= componentes->num)
+    {
+        fprintf(stderr, "componentes_tamanho: componente invalido\n");
+        exit(EXIT_FAILURE);
+    }
+
+    return componentes->offsets[c + 1] - componentes->offsets[c];
+}
+
+const int *componentes_vertices(componentes_t *componentes, int c)
+{
+    if (componentes == NULL || c < 0 || c >= componentes->num)
+    {
+        fprintf(stderr, "componentes_vertices: componente invalido\n");
+        exit(EXIT_FAILURE);
+    }
+
+    return componentes->vertices + componentes->offsets[c];
+}
+
+void libera_componentes(componentes_t *componentes)
+{
+    if (componentes == NULL)
+    {
+        fprintf(stderr, "libera_componentes: componentes invalidos\n");
+        exit(EXIT_FAILURE);
+    }
+
+    free(componentes->rotulo);
+    free(componentes->offsets);
+    free(componentes->vertices);
+    free(componentes);
+}
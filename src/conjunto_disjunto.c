@@ -0,0 +1,213 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "conjunto_disjunto.h"
+
+#define FALSE 0
+#define TRUE 1
+
+struct conjuntos_disjuntos
+{
+    int n;
+    int num_conjuntos;
+    int *pai;               /*!< pai[x] == x: x e representante */
+    unsigned char *posto;   /*!< Limite superior da altura da arvore de x */
+};
+
+/**
+  * @brief  Cria n conjuntos unitários {0}, {1}, ..., {n-1}
+  * @param	n: número de elementos
+  *
+  * @retval conjunto_disjunto_t: ponteiro para a nova estrutura
+  */
+conjunto_disjunto_t *cria_conjunto_disjunto(int n)
+{
+    conjunto_disjunto_t *p;
+    int i;
+
+    if (n < 0)
+    {
+        fprintf(stderr, "cria_conjunto_disjunto: tamanho invalido\n");
+        exit(EXIT_FAILURE);
+    }
+
+    p = malloc(sizeof(conjunto_disjunto_t));
+    if (p == NULL)
+    {
+        perror("cria_conjunto_disjunto:");
+        exit(EXIT_FAILURE);
+    }
+
+    p->n = n;
+    p->num_conjuntos = n;
+    p->pai = malloc((n > 0 ? n : 1) * sizeof(int));
+    p->posto = calloc(n > 0 ? n : 1, 1);
+
+    if (p->pai == NULL || p->posto == NULL)
+    {
+        perror("cria_conjunto_disjunto:");
+        exit(EXIT_FAILURE);
+    }
+
+    for (i = 0; i < n; i++)
+        p->pai[i] = i;
+
+    return p;
+}
+
+/**
+  * @brief  Encontra o representante do conjunto de x
+  * @param	conjuntos: estrutura union-find
+  * @param  x: elemento
+  *
+  * Todos os elementos do caminho até a raiz passam a apontar para ela.
+  *
+  * @retval int: representante
+  */
+int conjunto_encontrar(conjunto_disjunto_t *conjuntos, int x)
+{
+    int raiz, proximo;
+
+    if (conjuntos == NULL || x < 0 || x >= conjuntos->n)
+    {
+        fprintf(stderr, "conjunto_encontrar: elemento invalido\n");
+        exit(EXIT_FAILURE);
+    }
+
+    raiz = x;
+    while (conjuntos->pai[raiz] != raiz)
+        raiz = conjuntos->pai[raiz];
+
+    while (conjuntos->pai[x] != raiz)
+    {
+        proximo = conjuntos->pai[x];
+        conjuntos->pai[x] = raiz;
+        x = proximo;
+    }
+
+    return raiz;
+}
+
+/**
+  * @brief  Une os conjuntos de a e b
+  * @param	conjuntos: estrutura union-find
+  * @param  a, b: elementos
+  *
+  * A árvore de menor posto é pendurada na de maior posto.
+  *
+  * @retval int: TRUE se os conjuntos eram distintos
+  */
+int conjunto_unir(conjunto_disjunto_t *conjuntos, int a, int b)
+{
+    a = conjunto_encontrar(conjuntos, a);
+    b = conjunto_encontrar(conjuntos, b);
+
+    if (a == b)
+        return FALSE;
+
+    if (conjuntos->posto[a] < conjuntos->posto[b])
+        conjuntos->pai[a] = b;
+    else if (conjuntos->posto[a] > conjuntos->posto[b])
+        conjuntos->pai[b] = a;
+    else
+    {
+        conjuntos->pai[b] = a;
+        conjuntos->posto[a]++;
+    }
+
+    conjuntos->num_conjuntos--;
+
+    return TRUE;
+}
+
+/**
+  * @brief  Encontra o representante de x, podendo haver uniões simultâneas
+  * @param	conjuntos: estrutura union-find
+  * @param  x: elemento
+  *
+  * Cada elemento do caminho passa a apontar para o avô. A troca só ocorre
+  * se o pai não mudou, então o atalho nunca desfaz uma união concorrente.
+  *
+  * @retval int: representante no instante da leitura
+  */
+int conjunto_encontrar_concorrente(conjunto_disjunto_t *conjuntos, int x)
+{
+    int pai, avo;
+
+    if (conjuntos == NULL || x < 0 || x >= conjuntos->n)
+    {
+        fprintf(stderr, "conjunto_encontrar: elemento invalido\n");
+        exit(EXIT_FAILURE);
+    }
+
+    for (;;)
+    {
+        pai = __atomic_load_n(&conjuntos->pai[x], __ATOMIC_ACQUIRE);
+        if (pai == x)
+            return x;
+
+        avo = __atomic_load_n(&conjuntos->pai[pai], __ATOMIC_ACQUIRE);
+        if (avo != pai)
+            __atomic_compare_exchange_n(&conjuntos->pai[x], &pai, avo, FALSE,
+                                        __ATOMIC_RELEASE, __ATOMIC_RELAXED);
+        x = avo;
+    }
+}
+
+/**
+  * @brief  Une os conjuntos de a e b, podendo haver outras uniões simultâneas
+  * @param	conjuntos: estrutura union-find
+  * @param  a, b: elementos
+  *
+  * A raiz de maior índice passa a apontar para a de menor índice com uma
+  * troca atômica; se outra thread alterou a raiz antes, a busca recomeça.
+  * Entre duas threads unindo os mesmos conjuntos, exatamente uma retorna TRUE.
+  *
+  * @retval int: TRUE se esta chamada uniu conjuntos distintos
+  */
+int conjunto_unir_concorrente(conjunto_disjunto_t *conjuntos, int a, int b)
+{
+    int t;
+
+    for (;;)
+    {
+        a = conjunto_encontrar_concorrente(conjuntos, a);
+        b = conjunto_encontrar_concorrente(conjuntos, b);
+
+        if (a == b)
+            return FALSE;
+
+        if (a < b)
+        {
+            t = a;
+            a = b;
+            b = t;
+        }
+
+        t = a;
+        if (__atomic_compare_exchange_n(&conjuntos->pai[a], &t, b, FALSE,
+                                        __ATOMIC_ACQ_REL, __ATOMIC_RELAXED))
+        {
+            __atomic_fetch_sub(&conjuntos->num_conjuntos, 1, __ATOMIC_RELAXED);
+            return TRUE;
+        }
+    }
+}
+
+int conjunto_num_conjuntos(conjunto_disjunto_t *conjuntos)
+{
+    return conjuntos->num_conjuntos;
+}
+
+void libera_conjunto_disjunto(conjunto_disjunto_t *conjuntos)
+{
+    if (conjuntos == NULL)
+    {
+        fprintf(stderr, "libera_conjunto_disjunto: estrutura invalida\n");
+        exit(EXIT_FAILURE);
+    }
+
+    free(conjuntos->pai);
+    free(conjuntos->posto);
+    free(conjuntos);
+}
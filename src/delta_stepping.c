@@ -0,0 +1,417 @@
+/*
+ * delta_stepping.c
+ *
+ * Delta-stepping com relaxacoes atomicas. Distancia e antecessor de cada
+ * vertice formam uma chave de 64 bits reduzida por comparacao e troca, e os
+ * baldes sao preguicosos: um vertice melhorado e reinserido sem sair do
+ * balde antigo, e as copias vencidas sao descartadas ao esvaziar o balde.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#include <float.h>
+
+#include "delta_stepping.h"
+#include "paralelo.h"
+
+#define FALSE 0
+#define TRUE 1
+
+/* Vertices por tarefa: fronteiras menores sao relaxadas sem criar threads */
+#define DELTA_BLOCO 512
+
+/* Limite de baldes circulares: delta menor que C / DELTA_MAX_BALDES e
+ * alargado */
+#define DELTA_MAX_BALDES (1 << 20)
+
+/* Vetor de vertices que cresce sob demanda */
+typedef struct lista_vertices
+{
+    int *v;
+    int tamanho;
+    int capacidade;
+} lista_vertices_t;
+
+typedef struct delta_stepping
+{
+    int n;
+    float delta;
+    const int *offsets;
+    int *vizinhos;          /*!< Arestas de cada vertice: leves e depois pesadas */
+    float *pesos;
+    int *divisa;            /*!< Primeira aresta pesada de cada vertice */
+    const int *origem_vizinhos;
+    const float *origem_pesos;
+
+    uint64_t *estado;       /*!< (distancia, antecessor) de cada vertice */
+
+    /* Fase atual */
+    const int *fronteira;
+    int tamanho_fronteira;
+    int pesadas;
+    lista_vertices_t *melhorados;   /*!< Vertices melhorados por tarefa */
+} delta_stepping_t;
+
+static void *aloca(size_t tamanho)
+{
+    void *p = malloc(tamanho > 0 ? tamanho : 1);
+
+    if (p == NULL)
+    {
+        perror("delta_stepping:");
+        exit(EXIT_FAILURE);
+    }
+
+    return p;
+}
+
+static void lista_adiciona(lista_vertices_t *l, int v)
+{
+    if (l->tamanho == l->capacidade)
+    {
+        l->capacidade = l->capacidade ? 2 * l->capacidade : 64;
+        l->v = realloc(l->v, l->capacidade * sizeof(int));
+        if (l->v == NULL)
+        {
+            perror("delta_stepping:");
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    l->v[l->tamanho++] = v;
+}
+
+/* Distancia e antecessor em uma palavra, para serem trocados juntos. Os
+ * bits de distancias nao negativas, inclusive INFINITY, ja estao em ordem
+ * crescente */
+static uint64_t chave(float dist, int pai)
+{
+    uint32_t bits;
+
+    memcpy(&bits, &dist, sizeof(bits));
+
+    return ((uint64_t)bits << 32) | (uint32_t)pai;
+}
+
+static float chave_dist(uint64_t c)
+{
+    uint32_t bits = (uint32_t)(c >> 32);
+    float dist;
+
+    memcpy(&dist, &bits, sizeof(dist));
+
+    return dist;
+}
+
+static int chave_pai(uint64_t c)
+{
+    return (int)(uint32_t)c;
+}
+
+/* Grava valor em destino se a distancia for estritamente menor. Retorna
+ * TRUE se gravou. Em empates o antecessor nao muda: trocar por outro de
+ * mesma distancia poderia fechar ciclos de arestas de peso zero */
+static int minimo_atomico(uint64_t *destino, uint64_t valor)
+{
+    uint64_t atual = __atomic_load_n(destino, __ATOMIC_ACQUIRE);
+
+    while ((valor >> 32) < (atual >> 32))
+        if (__atomic_compare_exchange_n(destino, &atual, valor, TRUE,
+                                        __ATOMIC_RELEASE, __ATOMIC_ACQUIRE))
+            return TRUE;
+
+    return FALSE;
+}
+
+/* Reordena as arestas de um bloco de vertices: leves antes das pesadas */
+static void separa_bloco(void *contexto, int i)
+{
+    delta_stepping_t *d = contexto;
+    int u, k, leve, pesada, fim = (i + 1) * DELTA_BLOCO < d->n ? (i + 1) * DELTA_BLOCO : d->n;
+
+    for (u = i * DELTA_BLOCO; u < fim; u++)
+    {
+        leve = d->offsets[u];
+        for (k = d->offsets[u]; k < d->offsets[u + 1]; k++)
+            if (d->origem_pesos[k] <= d->delta)
+            {
+                d->vizinhos[leve] = d->origem_vizinhos[k];
+                d->pesos[leve] = d->origem_pesos[k];
+                leve++;
+            }
+
+        d->divisa[u] = leve;
+
+        pesada = leve;
+        for (k = d->offsets[u]; k < d->offsets[u + 1]; k++)
+            if (d->origem_pesos[k] > d->delta)
+            {
+                d->vizinhos[pesada] = d->origem_vizinhos[k];
+                d->pesos[pesada] = d->origem_pesos[k];
+                pesada++;
+            }
+    }
+}
+
+/* Relaxa as arestas leves ou pesadas de um bloco da fronteira */
+static void relaxa_bloco(void *contexto, int i)
+{
+    delta_stepping_t *d = contexto;
+    lista_vertices_t *melhorados = &d->melhorados[i];
+    int j, k, u, inicio, fim;
+    int ultimo = (i + 1) * DELTA_BLOCO < d->tamanho_fronteira ?
+                 (i + 1) * DELTA_BLOCO : d->tamanho_fronteira;
+    float du;
+
+    for (j = i * DELTA_BLOCO; j < ultimo; j++)
+    {
+        u = d->fronteira[j];
+        du = chave_dist(__atomic_load_n(&d->estado[u], __ATOMIC_ACQUIRE));
+        inicio = d->pesadas ? d->divisa[u] : d->offsets[u];
+        fim = d->pesadas ? d->offsets[u + 1] : d->divisa[u];
+
+        for (k = inicio; k < fim; k++)
+            if (minimo_atomico(&d->estado[d->vizinhos[k]], chave(du + d->pesos[k], u)))
+                lista_adiciona(melhorados, d->vizinhos[k]);
+    }
+}
+
+/* Relaxa a fronteira em paralelo. Os vertices melhorados ficam em
+ * d->melhorados[0 .. retorno) */
+static int relaxa(delta_stepping_t *d, const int *fronteira, int tamanho,
+                  int pesadas, int num_threads)
+{
+    int i, tarefas = (tamanho + DELTA_BLOCO - 1) / DELTA_BLOCO;
+
+    d->fronteira = fronteira;
+    d->tamanho_fronteira = tamanho;
+    d->pesadas = pesadas;
+    for (i = 0; i < tarefas; i++)
+        d->melhorados[i].tamanho = 0;
+
+    paralelo_executa(num_threads, tarefas, relaxa_bloco, d);
+
+    return tarefas;
+}
+
+/* Balde de uma distancia */
+static long long balde_de(delta_stepping_t *d, int v)
+{
+    return (long long)((double)chave_dist(d->estado[v]) / d->delta);
+}
+
+/* Insere os vertices melhorados das tarefas nos baldes das suas novas
+ * distancias. Retorna o numero de insercoes */
+static int distribui(delta_stepping_t *d, int tarefas, lista_vertices_t *baldes,
+                     int num_baldes)
+{
+    int i, j, v, total = 0;
+
+    for (i = 0; i < tarefas; i++)
+    {
+        for (j = 0; j < d->melhorados[i].tamanho; j++)
+        {
+            v = d->melhorados[i].v[j];
+            lista_adiciona(&baldes[balde_de(d, v) % num_baldes], v);
+        }
+        total += d->melhorados[i].tamanho;
+    }
+
+    return total;
+}
+
+float delta_stepping_delta(grafo_csr_t *csr)
+{
+    const float *pesos = csr_pesos(csr);
+    int k, m = csr_num_arestas(csr), n = csr_num_vertices(csr);
+    float maximo = 0;
+    double delta;
+
+    for (k = 0; k < m; k++)
+        if (pesos[k] > maximo)
+            maximo = pesos[k];
+
+    if (maximo == 0)
+        return 1;
+
+    /* Sempre aceito por delta_stepping_csr: positivo e finito */
+    delta = (double)maximo * n / m;
+    if (!(delta > 0) || delta > FLT_MAX)
+        return maximo;
+
+    return (float)delta;
+}
+
+/**
+  * @brief  Distâncias de fonte a todos os vértices por delta-stepping
+  * @param  csr: grafo com pesos não negativos
+  * @param  fonte: índice do vértice de origem
+  * @param  delta: largura dos baldes, positiva e finita
+  * @param  num_threads: número de threads (0: uma por núcleo)
+  * @param  dist: recebe as distâncias (INFINITY se inalcançável)
+  * @param  pai: recebe o antecessor no menor caminho
+  *
+  * Toda distância provisória pendente está a menos de delta + C do início
+  * do balde atual, C o maior peso, de modo que C / delta + 3 baldes
+  * circulares bastam. delta é alargado até que sejam no máximo
+  * DELTA_MAX_BALDES e até o espaçamento dos floats perto da maior
+  * distância possível, (n - 1) C: abaixo disso, o arredondamento das somas
+  * erra o balde. O resultado não muda. Ao esvaziar o balde i, um vértice só
+  * entra na fronteira se sua distância atual ainda for do balde i e se não
+  * tiver entrado nesta mesma fase.
+  *
+  * @retval Nenhum
+  */
+void delta_stepping_csr(grafo_csr_t *csr, int fonte, float delta, int num_threads,
+                        float *dist, int *pai)
+{
+    delta_stepping_t d;
+    lista_vertices_t *baldes, *b;
+    int *fronteira, *removidos, *na_fase, *removido_em;
+    int n, m, i, j, v, tarefas, num_baldes, tamanho_fronteira, num_removidos;
+    int fase = 0, primeira_fase, max_tarefas;
+    long long balde = 0, pendentes = 1;
+    float maximo = 0;
+    double minimo;
+
+    if (csr == NULL || fonte < 0 || fonte >= csr_num_vertices(csr) || !(delta > 0) ||
+        isinf(delta) || num_threads < 0 || dist == NULL || pai == NULL)
+    {
+        fprintf(stderr, "delta_stepping_csr: parametros invalidos\n");
+        exit(EXIT_FAILURE);
+    }
+
+    n = csr_num_vertices(csr);
+    m = csr_num_arestas(csr);
+
+    d.n = n;
+    d.delta = delta;
+    d.offsets = csr_offsets(csr);
+    d.origem_vizinhos = csr_vizinhos(csr);
+    d.origem_pesos = csr_pesos(csr);
+
+    for (j = 0; j < m; j++)
+    {
+        if (!(d.origem_pesos[j] >= 0))
+        {
+            fprintf(stderr, "delta_stepping_csr: peso negativo\n");
+            exit(EXIT_FAILURE);
+        }
+        if (d.origem_pesos[j] > maximo)
+            maximo = d.origem_pesos[j];
+    }
+
+    d.vizinhos = aloca(m * sizeof(int));
+    d.pesos = aloca(m * sizeof(float));
+    d.divisa = aloca(n * sizeof(int));
+    d.estado = aloca(n * sizeof(uint64_t));
+
+    paralelo_executa(num_threads, (n + DELTA_BLOCO - 1) / DELTA_BLOCO, separa_bloco, &d);
+
+    for (v = 0; v < n; v++)
+        d.estado[v] = chave(INFINITY, -1);
+    d.estado[fonte] = chave(0, -1);
+
+    max_tarefas = (n + DELTA_BLOCO - 1) / DELTA_BLOCO;
+    d.melhorados = aloca(max_tarefas * sizeof(lista_vertices_t));
+    for (i = 0; i < max_tarefas; i++)
+    {
+        d.melhorados[i].v = NULL;
+        d.melhorados[i].tamanho = 0;
+        d.melhorados[i].capacidade = 0;
+    }
+
+    /* Em double, pois C / delta pode estourar int */
+    minimo = fmax((double)maximo / (DELTA_MAX_BALDES - 4), (double)maximo * n * FLT_EPSILON);
+    if (d.delta < minimo)
+        d.delta = nextafterf((float)minimo, INFINITY);
+    num_baldes = (int)floor((double)maximo / d.delta) + 3;
+    baldes = aloca(num_baldes * sizeof(lista_vertices_t));
+    for (i = 0; i < num_baldes; i++)
+    {
+        baldes[i].v = NULL;
+        baldes[i].tamanho = 0;
+        baldes[i].capacidade = 0;
+    }
+
+    fronteira = aloca(n * sizeof(int));
+    removidos = aloca(n * sizeof(int));
+    na_fase = aloca(n * sizeof(int));
+    removido_em = aloca(n * sizeof(int));
+    for (v = 0; v < n; v++)
+    {
+        na_fase[v] = -1;
+        removido_em[v] = -1;
+    }
+
+    lista_adiciona(&baldes[0], fonte);
+
+    while (pendentes > 0)
+    {
+        b = &baldes[balde % num_baldes];
+        if (b->tamanho == 0)
+        {
+            balde++;
+            continue;
+        }
+
+        /* Arestas leves: podem devolver vertices ao proprio balde */
+        num_removidos = 0;
+        primeira_fase = fase;
+        while (b->tamanho > 0)
+        {
+            tamanho_fronteira = 0;
+            for (j = 0; j < b->tamanho; j++)
+            {
+                v = b->v[j];
+                if (balde_de(&d, v) != balde ||
+                    na_fase[v] == fase)
+                    continue;
+
+                na_fase[v] = fase;
+                fronteira[tamanho_fronteira++] = v;
+                if (removido_em[v] < primeira_fase)
+                {
+                    removido_em[v] = fase;
+                    removidos[num_removidos++] = v;
+                }
+            }
+            pendentes -= b->tamanho;
+            b->tamanho = 0;
+            fase++;
+
+            tarefas = relaxa(&d, fronteira, tamanho_fronteira, FALSE, num_threads);
+            pendentes += distribui(&d, tarefas, baldes, num_baldes);
+        }
+
+        /* Arestas pesadas: levam a baldes posteriores, a menos de
+         * arredondamento; se o balde atual voltar a ter vertices, ele e
+         * esvaziado de novo */
+        tarefas = relaxa(&d, removidos, num_removidos, TRUE, num_threads);
+        pendentes += distribui(&d, tarefas, baldes, num_baldes);
+    }
+
+    for (v = 0; v < n; v++)
+    {
+        dist[v] = chave_dist(d.estado[v]);
+        pai[v] = chave_pai(d.estado[v]);
+    }
+
+    for (i = 0; i < max_tarefas; i++)
+        free(d.melhorados[i].v);
+    for (i = 0; i < num_baldes; i++)
+        free(baldes[i].v);
+    free(d.melhorados);
+    free(baldes);
+    free(fronteira);
+    free(removidos);
+    free(na_fase);
+    free(removido_em);
+    free(d.vizinhos);
+    free(d.pesos);
+    free(d.divisa);
+    free(d.estado);
+}
@@ -0,0 +1,359 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "distancias.h"
+#include "algoritmos_csr.h"
+#include "tabela_hash.h"
+#include "paralelo.h"
+
+#define FALSE 0
+#define TRUE 1
+
+#define DISTANCIAS_MAGICO "GTAPSP1"
+
+/* Cabecalho do arquivo, seguido de n ids (int32) e da matriz, que comeca
+ * em um deslocamento multiplo de 8 */
+typedef struct cabecalho_distancias
+{
+    char magico[8];
+    int32_t n;
+    int32_t formato;
+    float escala;
+    int32_t reservado;
+} cabecalho_distancias_t;
+
+struct distancias
+{
+    int n;
+    formato_distancias_t formato;
+    float escala;
+    int32_t *ids;
+    void *matriz;               /*!< n * n elementos de 4 ou 2 bytes */
+    tabela_hash_t *indices;     /*!< id -> indice */
+
+    void *mapa;                 /*!< Regiao de mmap, NULL se em malloc */
+    size_t tamanho_mapa;
+};
+
+static void *aloca(size_t tamanho)
+{
+    void *p = malloc(tamanho > 0 ? tamanho : 1);
+
+    if (p == NULL)
+    {
+        perror("distancias:");
+        exit(EXIT_FAILURE);
+    }
+
+    return p;
+}
+
+static size_t tamanho_elemento(formato_distancias_t formato)
+{
+    return formato == DISTANCIAS_FLOAT32 ? sizeof(float) : sizeof(uint16_t);
+}
+
+/* Deslocamento da matriz no arquivo */
+static size_t inicio_matriz(int n)
+{
+    size_t inicio = sizeof(cabecalho_distancias_t) + (size_t)n * sizeof(int32_t);
+
+    return (inicio + 7) & ~(size_t)7;
+}
+
+static void cria_indices(distancias_t *d)
+{
+    int i;
+
+    d->indices = cria_tabela_hash(d->n);
+    for (i = 0; i < d->n; i++)
+        tabela_hash_inserir(d->indices, d->ids[i], i);
+}
+
+typedef struct apsp
+{
+    grafo_csr_t *csr;
+    distancias_t *distancias;
+    int proxima;                /*!< Proxima origem a calcular */
+} apsp_t;
+
+/* Uma tarefa por thread: calcula linhas ate acabarem as origens */
+static void calcula_linhas(void *contexto, int i)
+{
+    apsp_t *a = contexto;
+    distancias_t *d = a->distancias;
+    espaco_busca_t *espaco;
+    float *linha_f, dist, valor;
+    uint16_t *linha_u;
+    int s, v;
+
+    (void)i;
+    espaco = cria_espaco_busca(d->n, HEAP_DARIO);
+
+    for (;;)
+    {
+        s = __atomic_fetch_add(&a->proxima, 1, __ATOMIC_RELAXED);
+        if (s >= d->n)
+            break;
+
+        dijkstra_csr_espaco(a->csr, s, -1, espaco);
+
+        linha_f = (float *)d->matriz + (size_t)s * d->n;
+        linha_u = (uint16_t *)d->matriz + (size_t)s * d->n;
+
+        for (v = 0; v < d->n; v++)
+        {
+            dist = espaco_get_dist(espaco, v);
+
+            if (d->formato == DISTANCIAS_FLOAT32)
+                linha_f[v] = dist;
+            else if (dist == INFINITY)
+                linha_u[v] = DISTANCIAS_UINT16_INFINITO;
+            else
+            {
+                valor = roundf(dist * d->escala);
+                if (valor >= DISTANCIAS_UINT16_INFINITO)
+                {
+                    fprintf(stderr, "calcula_distancias: distancia %f nao cabe em 16 bits\n", dist);
+                    exit(EXIT_FAILURE);
+                }
+                linha_u[v] = (uint16_t)valor;
+            }
+        }
+    }
+
+    libera_espaco_busca(espaco);
+}
+
+/**
+  * @brief  Calcula as menores distâncias entre todos os pares
+  * @param	csr: grafo com pesos não negativos
+  * @param  formato: DISTANCIAS_FLOAT32 ou DISTANCIAS_UINT16
+  * @param  escala: multiplicador das distâncias em DISTANCIAS_UINT16
+  * @param  num_threads: número de threads (0: uma por núcleo)
+  *
+  * Cada thread reutiliza um espaço de busca e retira origens sob demanda;
+  * cada linha é escrita por uma única thread. O(V (E + V) log V).
+  *
+  * @retval distancias_t: matriz em memória
+  */
+distancias_t *calcula_distancias(grafo_csr_t *csr, formato_distancias_t formato,
+                                 float escala, int num_threads)
+{
+    distancias_t *d;
+    apsp_t a;
+    int i;
+
+    if (csr == NULL || num_threads < 0 ||
+        (formato != DISTANCIAS_FLOAT32 && formato != DISTANCIAS_UINT16) ||
+        (formato == DISTANCIAS_UINT16 && !(escala > 0)))
+    {
+        fprintf(stderr, "calcula_distancias: parametros invalidos\n");
+        exit(EXIT_FAILURE);
+    }
+
+    d = aloca(sizeof(distancias_t));
+    d->n = csr_num_vertices(csr);
+    d->formato = formato;
+    d->escala = formato == DISTANCIAS_UINT16 ? escala : 1;
+    d->ids = aloca(d->n * sizeof(int32_t));
+    d->matriz = aloca((size_t)d->n * d->n * tamanho_elemento(formato));
+    d->mapa = NULL;
+    d->tamanho_mapa = 0;
+
+    for (i = 0; i < d->n; i++)
+        d->ids[i] = csr_id(csr, i);
+    cria_indices(d);
+
+    if (num_threads == 0)
+        num_threads = paralelo_num_threads();
+
+    a.csr = csr;
+    a.distancias = d;
+    a.proxima = 0;
+    paralelo_executa(num_threads, num_threads < d->n ? num_threads : d->n, calcula_linhas, &a);
+
+    return d;
+}
+
+/**
+  * @brief  Grava a matriz em arquivo binário
+  * @param	distancias: matriz calculada ou carregada
+  * @param  arquivo: caminho do arquivo
+  *
+  * O arquivo usa a ordem de bytes da máquina.
+  *
+  * @retval Nenhum
+  */
+void salva_distancias(distancias_t *distancias, const char *arquivo)
+{
+    cabecalho_distancias_t c;
+    static const char zeros[8] = {0};
+    size_t preenchimento, elementos;
+    FILE *fp;
+
+    if (distancias == NULL || arquivo == NULL)
+    {
+        fprintf(stderr, "salva_distancias: parametros invalidos\n");
+        exit(EXIT_FAILURE);
+    }
+
+    fp = fopen(arquivo, "wb");
+    if (fp == NULL)
+    {
+        perror("salva_distancias:");
+        exit(EXIT_FAILURE);
+    }
+
+    memset(&c, 0, sizeof(c));
+    memcpy(c.magico, DISTANCIAS_MAGICO, sizeof(c.magico));
+    c.n = distancias->n;
+    c.formato = distancias->formato;
+    c.escala = distancias->escala;
+
+    preenchimento = inicio_matriz(c.n) - sizeof(c) - (size_t)c.n * sizeof(int32_t);
+    elementos = (size_t)c.n * c.n;
+
+    if (fwrite(&c, sizeof(c), 1, fp) != 1 ||
+        fwrite(distancias->ids, sizeof(int32_t), c.n, fp) != (size_t)c.n ||
+        fwrite(zeros, 1, preenchimento, fp) != preenchimento ||
+        fwrite(distancias->matriz, tamanho_elemento(distancias->formato), elementos, fp) != elementos ||
+        fclose(fp) != 0)
+    {
+        perror("salva_distancias:");
+        exit(EXIT_FAILURE);
+    }
+}
+
+/**
+  * @brief  Abre uma matriz gravada por salva_distancias
+  * @param	arquivo: caminho do arquivo
+  *
+  * O arquivo é mapeado na memória; as páginas da matriz só são lidas do
+  * disco quando consultadas.
+  *
+  * @retval distancias_t: matriz somente leitura
+  */
+distancias_t *carrega_distancias(const char *arquivo)
+{
+    cabecalho_distancias_t c;
+    struct stat info;
+    distancias_t *d;
+    int fd;
+
+    fd = open(arquivo, O_RDONLY);
+    if (fd < 0)
+    {
+        perror("carrega_distancias:");
+        exit(EXIT_FAILURE);
+    }
+
+    d = aloca(sizeof(distancias_t));
+
+    if (fstat(fd, &info) != 0 || (size_t)info.st_size < sizeof(c))
+    {
+        fprintf(stderr, "carrega_distancias: arquivo invalido: %s\n", arquivo);
+        exit(EXIT_FAILURE);
+    }
+
+    d->tamanho_mapa = info.st_size;
+    d->mapa = mmap(NULL, d->tamanho_mapa, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+
+    if (d->mapa == MAP_FAILED)
+    {
+        perror("carrega_distancias:");
+        exit(EXIT_FAILURE);
+    }
+
+    memcpy(&c, d->mapa, sizeof(c));
+    if (memcmp(c.magico, DISTANCIAS_MAGICO, sizeof(c.magico)) != 0 || c.n < 0 ||
+        (c.formato != DISTANCIAS_FLOAT32 && c.formato != DISTANCIAS_UINT16) ||
+        d->tamanho_mapa < inicio_matriz(c.n) + (size_t)c.n * c.n * tamanho_elemento(c.formato))
+    {
+        fprintf(stderr, "carrega_distancias: arquivo invalido: %s\n", arquivo);
+        exit(EXIT_FAILURE);
+    }
+
+    d->n = c.n;
+    d->formato = c.formato;
+    d->escala = c.escala;
+    d->ids = (int32_t *)((char *)d->mapa + sizeof(c));
+    d->matriz = (char *)d->mapa + inicio_matriz(c.n);
+    cria_indices(d);
+
+    return d;
+}
+
+int distancias_num_vertices(distancias_t *distancias)
+{
+    return distancias->n;
+}
+
+formato_distancias_t distancias_formato(distancias_t *distancias)
+{
+    return distancias->formato;
+}
+
+int distancias_indice(distancias_t *distancias, int id)
+{
+    return tabela_hash_buscar(distancias->indices, id);
+}
+
+float distancias_consulta(distancias_t *distancias, int u, int v)
+{
+    uint16_t valor;
+
+    if (distancias == NULL || u < 0 || v < 0 || u >= distancias->n || v >= distancias->n)
+    {
+        fprintf(stderr, "distancias_consulta: vertice invalido\n");
+        exit(EXIT_FAILURE);
+    }
+
+    if (distancias->formato == DISTANCIAS_FLOAT32)
+        return ((const float *)distancias->matriz)[(size_t)u * distancias->n + v];
+
+    valor = ((const uint16_t *)distancias->matriz)[(size_t)u * distancias->n + v];
+
+    return valor == DISTANCIAS_UINT16_INFINITO ? INFINITY : valor / distancias->escala;
+}
+
+const void *distancias_linha(distancias_t *distancias, int u)
+{
+    if (distancias == NULL || u < 0 || u >= distancias->n)
+    {
+        fprintf(stderr, "distancias_linha: vertice invalido\n");
+        exit(EXIT_FAILURE);
+    }
+
+    return (const char *)distancias->matriz +
+           (size_t)u * distancias->n * tamanho_elemento(distancias->formato);
+}
+
+void libera_distancias(distancias_t *distancias)
+{
+    if (distancias == NULL)
+    {
+        fprintf(stderr, "libera_distancias: matriz invalida\n");
+        exit(EXIT_FAILURE);
+    }
+
+    libera_tabela_hash(distancias->indices);
+
+    if (distancias->mapa)
+        munmap(distancias->mapa, distancias->tamanho_mapa);
+    else
+    {
+        free(distancias->ids);
+        free(distancias->matriz);
+    }
+
+    free(distancias);
+}
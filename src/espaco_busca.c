@@ -0,0 +1,215 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "espaco_busca.h"
+
+#define FALSE 0
+#define TRUE 1
+
+struct espacos_busca
+{
+    int n;
+    unsigned int geracao_atual;
+    unsigned int *geracao;      /*!< Geracao em que cada vertice foi tocado */
+    unsigned char *visitado;
+    float *dist;
+    int *pai;
+    arestas_t **aresta;
+
+    fila_prioridade_t *fila;    /*!< Fila de prioridade reutilizavel */
+    int *vetor;                 /*!< Fila/pilha de indices */
+    no_t **cursores;            /*!< Proxima aresta a examinar, por vertice */
+};
+
+static void *aloca(size_t tamanho)
+{
+    void *p = malloc(tamanho > 0 ? tamanho : 1);
+
+    if (p == NULL)
+    {
+        perror("cria_espaco_busca:");
+        exit(EXIT_FAILURE);
+    }
+
+    return p;
+}
+
+/**
+  * @brief  Cria o estado de consulta para um grafo de até n vértices
+  * @param	n: número de vértices do grafo
+  * @param  tipo: implementação da fila de prioridade (HEAP_DARIO ou HEAP_PAREAMENTO)
+  *
+  * @retval espaco_busca_t: ponteiro para o novo espaço, já reiniciado
+  */
+espaco_busca_t *cria_espaco_busca(int n, tipo_heap_t tipo)
+{
+    espaco_busca_t *p = aloca(sizeof(espaco_busca_t));
+    int i;
+
+    if (n < 0)
+    {
+        fprintf(stderr, "cria_espaco_busca: tamanho invalido\n");
+        exit(EXIT_FAILURE);
+    }
+
+    p->n = n;
+    p->geracao_atual = 1;
+    p->geracao = aloca(n * sizeof(unsigned int));
+    p->visitado = aloca(n);
+    p->dist = aloca(n * sizeof(float));
+    p->pai = aloca(n * sizeof(int));
+    p->aresta = aloca(n * sizeof(arestas_t*));
+    p->fila = cria_fila_prioridade(n, tipo, FILA_PRIORIDADE_ARIDADE);
+    p->vetor = aloca(n * sizeof(int));
+    p->cursores = aloca(n * sizeof(no_t*));
+
+    for (i = 0; i < n; i++)
+        p->geracao[i] = 0;
+
+    return p;
+}
+
+void libera_espaco_busca(espaco_busca_t *espaco)
+{
+    if (espaco == NULL)
+    {
+        fprintf(stderr, "libera_espaco_busca: espaco invalido\n");
+        exit(EXIT_FAILURE);
+    }
+
+    libera_fila_prioridade(espaco->fila);
+    free(espaco->geracao);
+    free(espaco->visitado);
+    free(espaco->dist);
+    free(espaco->pai);
+    free(espaco->aresta);
+    free(espaco->vetor);
+    free(espaco->cursores);
+    free(espaco);
+}
+
+/**
+  * @brief  Descarta o estado da consulta anterior
+  * @param	espaco: espaço de busca
+  *
+  * Apenas incrementa a geração; os vetores só são varridos quando o contador
+  * dá a volta, uma vez a cada 2^32 consultas.
+  *
+  * @retval Nenhum
+  */
+void espaco_reinicia(espaco_busca_t *espaco)
+{
+    int i;
+
+    if (espaco == NULL)
+    {
+        fprintf(stderr, "espaco_reinicia: espaco invalido\n");
+        exit(EXIT_FAILURE);
+    }
+
+    espaco->geracao_atual++;
+    if (espaco->geracao_atual == 0)
+    {
+        for (i = 0; i < espaco->n; i++)
+            espaco->geracao[i] = 0;
+        espaco->geracao_atual = 1;
+    }
+
+    fila_prioridade_limpar(espaco->fila);
+}
+
+int espaco_num_vertices(espaco_busca_t *espaco)
+{
+    return espaco->n;
+}
+
+/* Leva o vertice para a geracao atual, com o estado inicial */
+static void toca(espaco_busca_t *espaco, int v)
+{
+    if (v < 0 || v >= espaco->n)
+    {
+        fprintf(stderr, "espaco_busca: vertice invalido\n");
+        exit(EXIT_FAILURE);
+    }
+
+    if (espaco->geracao[v] != espaco->geracao_atual)
+    {
+        espaco->geracao[v] = espaco->geracao_atual;
+        espaco->visitado[v] = FALSE;
+        espaco->dist[v] = INFINITY;
+        espaco->pai[v] = -1;
+        espaco->aresta[v] = NULL;
+    }
+}
+
+int espaco_visitado(espaco_busca_t *espaco, int v)
+{
+    toca(espaco, v);
+
+    return espaco->visitado[v];
+}
+
+void espaco_visita(espaco_busca_t *espaco, int v)
+{
+    toca(espaco, v);
+
+    espaco->visitado[v] = TRUE;
+}
+
+float espaco_get_dist(espaco_busca_t *espaco, int v)
+{
+    toca(espaco, v);
+
+    return espaco->dist[v];
+}
+
+void espaco_set_dist(espaco_busca_t *espaco, int v, float dist)
+{
+    toca(espaco, v);
+
+    espaco->dist[v] = dist;
+}
+
+int espaco_get_pai(espaco_busca_t *espaco, int v)
+{
+    toca(espaco, v);
+
+    return espaco->pai[v];
+}
+
+void espaco_set_pai(espaco_busca_t *espaco, int v, int pai)
+{
+    toca(espaco, v);
+
+    espaco->pai[v] = pai;
+}
+
+arestas_t *espaco_get_aresta(espaco_busca_t *espaco, int v)
+{
+    toca(espaco, v);
+
+    return espaco->aresta[v];
+}
+
+void espaco_set_aresta(espaco_busca_t *espaco, int v, arestas_t *aresta)
+{
+    toca(espaco, v);
+
+    espaco->aresta[v] = aresta;
+}
+
+fila_prioridade_t *espaco_fila_prioridade(espaco_busca_t *espaco)
+{
+    return espaco->fila;
+}
+
+int *espaco_vetor(espaco_busca_t *espaco)
+{
+    return espaco->vetor;
+}
+
+no_t **espaco_cursores(espaco_busca_t *espaco)
+{
+    return espaco->cursores;
+}
@@ -1,18 +1,63 @@
 #include <stdlib.h>
 #include <stdio.h>
 
-#include "no.h"
 #include "fila.h"
-#include "lista_enc.h"
 
 #define FALSO 0
 #define VERDADEIRO 1
 
+/* Capacidade de cria_fila */
+#define FILA_CAPACIDADE_INICIAL 16
+
 struct filas {
-	lista_enc_t *dados;     /*!< Lista encadeada que contém os dados enfileirados */
+	void **dados;           /*!< Buffer circular com os dados enfileirados */
+	unsigned int mascara;   /*!< Capacidade - 1 (capacidade potencia de dois) */
+	unsigned int cabeca;    /*!< Posicao do proximo dado a sair */
+	unsigned int tamanho;   /*!< Numero de dados enfileirados */
 };
 
 
+/**
+  * @brief  Cria uma nova fila genérica com capacidade inicial
+  * @param capacidade: número de dados que cabem sem realocação
+  *
+  * A capacidade é arredondada para a próxima potência de dois, de modo que
+  * a posição circular é obtida com uma máscara em vez de divisão.
+  *
+  * @retval fila_t: ponteiro para uma nova fila
+  */
+fila_t * cria_fila_tamanho (int capacidade)
+{
+	fila_t *p;
+	unsigned int cap = 1;
+
+	if (capacidade < 0) {
+		fprintf(stderr, "cria_fila: capacidade invalida\n");
+		exit(EXIT_FAILURE);
+	}
+
+	while (cap < (unsigned int)capacidade)
+		cap <<= 1;
+
+	p = (fila_t*)malloc(sizeof(fila_t));
+	if (p == NULL) {
+		fprintf(stderr, "Erro alocando dados em cria_fila!\n");
+		exit(EXIT_FAILURE);
+	}
+
+	p->dados = malloc(cap * sizeof(void*));
+	if (p->dados == NULL) {
+		fprintf(stderr, "Erro alocando dados em cria_fila!\n");
+		exit(EXIT_FAILURE);
+	}
+
+	p->mascara = cap - 1;
+	p->cabeca = 0;
+	p->tamanho = 0;
+
+	return p;
+}
+
 /**
   * @brief  Cria uma nova fila genérica
   *
@@ -20,16 +65,28 @@ struct filas {
   */
 fila_t * cria_fila (void)
 {
-	fila_t *p = (fila_t*)malloc(sizeof(fila_t));
+	return cria_fila_tamanho(FILA_CAPACIDADE_INICIAL);
+}
 
-    if (p == NULL) {
-        fprintf(stderr, "Erro alocando dados em cria_fila!\n");
-        exit(EXIT_FAILURE);
-    }
+/* Dobra o buffer, desenrolando os dados a partir da cabeca */
+static void aumenta_fila(fila_t *fila)
+{
+	unsigned int i, cap = fila->mascara + 1;
+	void **novo;
+
+	novo = malloc(2 * cap * sizeof(void*));
+	if (novo == NULL) {
+		fprintf(stderr, "Erro alocando dados em enqueue!\n");
+		exit(EXIT_FAILURE);
+	}
 
-    p->dados = cria_lista_enc();
+	for (i = 0; i < fila->tamanho; i++)
+		novo[i] = fila->dados[(fila->cabeca + i) & fila->mascara];
 
-    return p;
+	free(fila->dados);
+	fila->dados = novo;
+	fila->cabeca = 0;
+	fila->mascara = 2 * cap - 1;
 }
 
 
@@ -42,19 +99,20 @@ fila_t * cria_fila (void)
   */
 void enqueue(void* dado, fila_t *fila)
 {
-	no_t *no;
-
     if (fila == NULL) {
-        fprintf(stderr, "push: pilha invalida\n");
+        fprintf(stderr, "enqueue: fila invalida\n");
         exit(EXIT_FAILURE);
     }
 
     #ifdef DEBUG
-    printf("enqueue: %x\n", dado);
+    printf("enqueue: %p\n", dado);
     #endif // DEBUG
 
-    no = cria_no(dado);
-    add_cauda(fila->dados, no);
+    if (fila->tamanho == fila->mascara + 1)
+        aumenta_fila(fila);
+
+    fila->dados[(fila->cabeca + fila->tamanho) & fila->mascara] = dado;
+    fila->tamanho++;
 }
 
 
@@ -62,11 +120,10 @@ void enqueue(void* dado, fila_t *fila)
   * @brief Retira da fila um dado.
   * @param fila: fila criada que retornará o dado.
   *
-  * @retval Nenhum
+  * @retval void *: Referência do dado mais antigo da fila
   */
 void *dequeue(fila_t *fila)
 {
-	no_t *no;
 	void *dado;
 
     if (fila == NULL){
@@ -74,9 +131,14 @@ void *dequeue(fila_t *fila)
         exit(EXIT_FAILURE);
     }
 
-    no = remover_cabeca(fila->dados);
-    dado = obter_dado(no);
-    free(no);
+    if (fila->tamanho == 0){
+        fprintf(stderr, "dequeue: fila vazia!\n");
+        exit(EXIT_FAILURE);
+    }
+
+    dado = fila->dados[fila->cabeca];
+    fila->cabeca = (fila->cabeca + 1) & fila->mascara;
+    fila->tamanho--;
 
     return dado;
 }
@@ -94,7 +156,7 @@ void libera_fila(fila_t* fila)
         exit(EXIT_FAILURE);
     }
 
-    if (!lista_vazia(fila->dados)){
+    if (fila->tamanho > 0){
     	fprintf(stderr, "Impossivel liberar fila, ainda ha dados\n");
 		exit(EXIT_FAILURE);
     }
@@ -116,5 +178,21 @@ int fila_vazia(fila_t *fila)
         exit(EXIT_FAILURE);
     }
 
-    return lista_vazia(fila->dados);
+    return fila->tamanho == 0 ? VERDADEIRO : FALSO;
+}
+
+/**
+  * @brief Retorna o número de dados na fila
+  * @param fila: fila criada
+  *
+  * @retval int: número de dados enfileirados
+  */
+int fila_tamanho(fila_t *fila)
+{
+    if (fila == NULL) {
+        fprintf(stderr, "fila_tamanho: fila invalida\n");
+        exit(EXIT_FAILURE);
+    }
+
+    return (int)fila->tamanho;
 }
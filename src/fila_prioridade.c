@@ -0,0 +1,496 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+
+#include "fila_prioridade.h"
+
+#define FALSE 0
+#define TRUE 1
+
+#define AUSENTE -1
+
+struct filas_prioridade {
+    tipo_heap_t tipo;    /*!< Implementacao utilizada: d-ario ou pairing heap */
+    int capacidade;      /*!< Numero de chaves possiveis: [0, capacidade) */
+    int tamanho;         /*!< Numero de chaves atualmente na fila */
+    float *prioridade;   /*!< Prioridade de cada chave */
+    uint64_t *desempate; /*!< Desempate entre prioridades iguais */
+    int *pos;            /*!< Posicao da chave no heap. AUSENTE se fora da fila */
+
+    /* Heap d-ario */
+    int aridade;
+    int *heap;           /*!< Vetor implicito do heap: heap[0] e a raiz */
+
+    /* Pairing heap: arvore multipla em representacao filho/irmao */
+    int raiz;
+    int *filho;          /*!< Primeiro filho da chave */
+    int *irmao;          /*!< Proximo irmao da chave */
+    int *anterior;       /*!< Irmao anterior, ou pai se for o primeiro filho */
+    int *auxiliar;       /*!< Vetor de trabalho da remocao em duas passadas */
+};
+
+static void *aloca_vetor(int n, size_t tamanho)
+{
+    void *p = malloc((n > 0 ? n : 1) * tamanho);
+
+    if (p == NULL) {
+        perror("cria_fila_prioridade:");
+        exit(EXIT_FAILURE);
+    }
+
+    return p;
+}
+
+/**
+  * @brief  Cria uma fila de prioridade indexada
+  * @param  capacidade: chaves validas estao em [0, capacidade)
+  * @param  tipo: HEAP_DARIO ou HEAP_PAREAMENTO
+  * @param  aridade: filhos por no do heap d-ario (>= 2)
+  *
+  * @retval fila_prioridade_t: ponteiro para uma nova fila vazia
+  */
+fila_prioridade_t *cria_fila_prioridade(int capacidade, tipo_heap_t tipo, int aridade)
+{
+    fila_prioridade_t *p;
+    int i;
+
+    if (capacidade < 0 || (tipo == HEAP_DARIO && aridade < 2)) {
+        fprintf(stderr, "cria_fila_prioridade: parametros invalidos\n");
+        exit(EXIT_FAILURE);
+    }
+
+    p = malloc(sizeof(fila_prioridade_t));
+    if (p == NULL) {
+        perror("cria_fila_prioridade:");
+        exit(EXIT_FAILURE);
+    }
+
+    p->tipo = tipo;
+    p->capacidade = capacidade;
+    p->tamanho = 0;
+    p->aridade = aridade;
+    p->raiz = AUSENTE;
+    p->heap = NULL;
+    p->filho = NULL;
+    p->irmao = NULL;
+    p->anterior = NULL;
+    p->auxiliar = NULL;
+
+    p->prioridade = aloca_vetor(capacidade, sizeof(float));
+    p->desempate = aloca_vetor(capacidade, sizeof(uint64_t));
+    p->pos = aloca_vetor(capacidade, sizeof(int));
+    for (i = 0; i < capacidade; i++)
+        p->pos[i] = AUSENTE;
+
+    if (tipo == HEAP_DARIO) {
+        p->heap = aloca_vetor(capacidade, sizeof(int));
+    } else {
+        p->filho = aloca_vetor(capacidade, sizeof(int));
+        p->irmao = aloca_vetor(capacidade, sizeof(int));
+        p->anterior = aloca_vetor(capacidade, sizeof(int));
+        p->auxiliar = aloca_vetor(capacidade, sizeof(int));
+    }
+
+    return p;
+}
+
+static void verifica_chave(fila_prioridade_t *fila, int chave)
+{
+    if (fila == NULL || chave < 0 || chave >= fila->capacidade) {
+        fprintf(stderr, "fila_prioridade: chave invalida\n");
+        exit(EXIT_FAILURE);
+    }
+}
+
+/* Ordem de (prioridade, desempate) */
+static int precede(fila_prioridade_t *fila, int a, int b)
+{
+    if (fila->prioridade[a] != fila->prioridade[b])
+        return fila->prioridade[a] < fila->prioridade[b];
+
+    return fila->desempate[a] < fila->desempate[b];
+}
+
+/*------------------------------------------*/
+/* Heap d-ario */
+
+static void dario_subir(fila_prioridade_t *fila, int i)
+{
+    int chave = fila->heap[i];
+    int pai;
+
+    while (i > 0) {
+        pai = (i - 1) / fila->aridade;
+        if (!precede(fila, chave, fila->heap[pai]))
+            break;
+        fila->heap[i] = fila->heap[pai];
+        fila->pos[fila->heap[i]] = i;
+        i = pai;
+    }
+
+    fila->heap[i] = chave;
+    fila->pos[chave] = i;
+}
+
+static void dario_descer(fila_prioridade_t *fila, int i)
+{
+    int chave = fila->heap[i];
+    int primeiro, ultimo, menor, c;
+
+    for (;;) {
+        primeiro = i * fila->aridade + 1;
+        if (primeiro >= fila->tamanho)
+            break;
+
+        ultimo = primeiro + fila->aridade;
+        if (ultimo > fila->tamanho)
+            ultimo = fila->tamanho;
+
+        menor = primeiro;
+        for (c = primeiro + 1; c < ultimo; c++)
+            if (precede(fila, fila->heap[c], fila->heap[menor]))
+                menor = c;
+
+        if (!precede(fila, fila->heap[menor], chave))
+            break;
+
+        fila->heap[i] = fila->heap[menor];
+        fila->pos[fila->heap[i]] = i;
+        i = menor;
+    }
+
+    fila->heap[i] = chave;
+    fila->pos[chave] = i;
+}
+
+/*------------------------------------------*/
+/* Pairing heap */
+
+/* Une duas arvores e retorna a nova raiz */
+static int pareamento_unir(fila_prioridade_t *fila, int a, int b)
+{
+    int t;
+
+    if (a == AUSENTE)
+        return b;
+    if (b == AUSENTE)
+        return a;
+
+    if (precede(fila, b, a)) {
+        t = a;
+        a = b;
+        b = t;
+    }
+
+    /* b torna-se o primeiro filho de a */
+    fila->irmao[b] = fila->filho[a];
+    if (fila->filho[a] != AUSENTE)
+        fila->anterior[fila->filho[a]] = b;
+    fila->anterior[b] = a;
+    fila->filho[a] = b;
+    fila->irmao[a] = AUSENTE;
+    fila->anterior[a] = AUSENTE;
+
+    return a;
+}
+
+/* Remove a subarvore de chave da lista de irmaos em que esta */
+static void pareamento_cortar(fila_prioridade_t *fila, int chave)
+{
+    int ant = fila->anterior[chave];
+
+    if (fila->filho[ant] == chave)
+        fila->filho[ant] = fila->irmao[chave];
+    else
+        fila->irmao[ant] = fila->irmao[chave];
+
+    if (fila->irmao[chave] != AUSENTE)
+        fila->anterior[fila->irmao[chave]] = ant;
+
+    fila->irmao[chave] = AUSENTE;
+    fila->anterior[chave] = AUSENTE;
+}
+
+/* Combina os filhos da raiz removida em duas passadas */
+static int pareamento_combinar(fila_prioridade_t *fila, int primeiro)
+{
+    int n = 0, i, a, b, resultado;
+
+    while (primeiro != AUSENTE) {
+        a = primeiro;
+        b = fila->irmao[a];
+        primeiro = (b != AUSENTE) ? fila->irmao[b] : AUSENTE;
+
+        fila->irmao[a] = AUSENTE;
+        fila->anterior[a] = AUSENTE;
+        if (b != AUSENTE) {
+            fila->irmao[b] = AUSENTE;
+            fila->anterior[b] = AUSENTE;
+        }
+
+        fila->auxiliar[n++] = pareamento_unir(fila, a, b);
+    }
+
+    resultado = AUSENTE;
+    for (i = n - 1; i >= 0; i--)
+        resultado = pareamento_unir(fila, fila->auxiliar[i], resultado);
+
+    return resultado;
+}
+
+/*------------------------------------------*/
+
+/**
+  * @brief  Insere uma chave na fila
+  * @param  fila: fila de prioridade
+  * @param  chave: chave ausente da fila
+  * @param  prioridade: prioridade da chave
+  * @param  desempate: ordena chaves de mesma prioridade (menor sai antes)
+  *
+  * @retval Nenhum
+  */
+void fila_prioridade_inserir_desempate(fila_prioridade_t *fila, int chave, float prioridade,
+                                       uint64_t desempate)
+{
+    verifica_chave(fila, chave);
+
+    if (fila->pos[chave] != AUSENTE) {
+        fprintf(stderr, "fila_prioridade_inserir: chave duplicada\n");
+        exit(EXIT_FAILURE);
+    }
+
+    fila->prioridade[chave] = prioridade;
+    fila->desempate[chave] = desempate;
+
+    if (fila->tipo == HEAP_DARIO) {
+        fila->heap[fila->tamanho] = chave;
+        fila->tamanho++;
+        dario_subir(fila, fila->tamanho - 1);
+    } else {
+        fila->pos[chave] = TRUE;
+        fila->filho[chave] = AUSENTE;
+        fila->irmao[chave] = AUSENTE;
+        fila->anterior[chave] = AUSENTE;
+        fila->raiz = pareamento_unir(fila, fila->raiz, chave);
+        fila->tamanho++;
+    }
+}
+
+void fila_prioridade_inserir(fila_prioridade_t *fila, int chave, float prioridade)
+{
+    fila_prioridade_inserir_desempate(fila, chave, prioridade, 0);
+}
+
+/**
+  * @brief  Diminui a prioridade de uma chave (decrease-key)
+  * @param  fila: fila de prioridade
+  * @param  chave: chave presente na fila
+  * @param  prioridade: nova prioridade, menor ou igual a atual
+  * @param  desempate: novo desempate; com prioridade igual, nao maior que o atual
+  *
+  * @retval Nenhum
+  */
+void fila_prioridade_diminuir_desempate(fila_prioridade_t *fila, int chave, float prioridade,
+                                        uint64_t desempate)
+{
+    verifica_chave(fila, chave);
+
+    if (fila->pos[chave] == AUSENTE || prioridade > fila->prioridade[chave] ||
+        (prioridade == fila->prioridade[chave] && desempate > fila->desempate[chave])) {
+        fprintf(stderr, "fila_prioridade_diminuir: chave ausente ou prioridade maior\n");
+        exit(EXIT_FAILURE);
+    }
+
+    fila->prioridade[chave] = prioridade;
+    fila->desempate[chave] = desempate;
+
+    if (fila->tipo == HEAP_DARIO) {
+        dario_subir(fila, fila->pos[chave]);
+    } else if (chave != fila->raiz) {
+        pareamento_cortar(fila, chave);
+        fila->raiz = pareamento_unir(fila, fila->raiz, chave);
+    }
+}
+
+void fila_prioridade_diminuir(fila_prioridade_t *fila, int chave, float prioridade)
+{
+    fila_prioridade_diminuir_desempate(fila, chave, prioridade, 0);
+}
+
+/**
+  * @brief  Insere uma chave ou diminui sua prioridade, se for menor
+  * @param  fila: fila de prioridade
+  * @param  chave: chave a ser atualizada
+  * @param  prioridade: prioridade candidata
+  * @param  desempate: desempate candidato, comparado se as prioridades forem iguais
+  *
+  * @retval int: TRUE se a chave foi inserida ou teve a prioridade diminuida
+  */
+int fila_prioridade_atualizar_desempate(fila_prioridade_t *fila, int chave, float prioridade,
+                                        uint64_t desempate)
+{
+    verifica_chave(fila, chave);
+
+    if (fila->pos[chave] == AUSENTE) {
+        fila_prioridade_inserir_desempate(fila, chave, prioridade, desempate);
+        return TRUE;
+    }
+
+    if (prioridade < fila->prioridade[chave] ||
+        (prioridade == fila->prioridade[chave] && desempate < fila->desempate[chave])) {
+        fila_prioridade_diminuir_desempate(fila, chave, prioridade, desempate);
+        return TRUE;
+    }
+
+    return FALSE;
+}
+
+int fila_prioridade_atualizar(fila_prioridade_t *fila, int chave, float prioridade)
+{
+    verifica_chave(fila, chave);
+
+    if (fila->pos[chave] != AUSENTE && prioridade >= fila->prioridade[chave])
+        return FALSE;
+
+    return fila_prioridade_atualizar_desempate(fila, chave, prioridade, 0);
+}
+
+/**
+  * @brief  Consulta a chave de menor prioridade sem remove-la
+  * @param  fila: fila de prioridade nao vazia
+  * @param  prioridade: recebe a prioridade da chave (pode ser NULL)
+  *
+  * @retval int: chave de menor prioridade
+  */
+int fila_prioridade_minimo(fila_prioridade_t *fila, float *prioridade)
+{
+    int chave;
+
+    if (fila == NULL || fila->tamanho == 0) {
+        fprintf(stderr, "fila_prioridade_minimo: fila vazia\n");
+        exit(EXIT_FAILURE);
+    }
+
+    chave = fila->tipo == HEAP_DARIO ? fila->heap[0] : fila->raiz;
+
+    if (prioridade)
+        *prioridade = fila->prioridade[chave];
+
+    return chave;
+}
+
+/**
+  * @brief  Remove a chave de menor prioridade
+  * @param  fila: fila de prioridade nao vazia
+  * @param  prioridade: recebe a prioridade da chave removida (pode ser NULL)
+  *
+  * @retval int: chave removida
+  */
+int fila_prioridade_remover_min(fila_prioridade_t *fila, float *prioridade)
+{
+    int chave;
+
+    if (fila == NULL || fila->tamanho == 0) {
+        fprintf(stderr, "fila_prioridade_remover_min: fila vazia\n");
+        exit(EXIT_FAILURE);
+    }
+
+    if (fila->tipo == HEAP_DARIO) {
+        chave = fila->heap[0];
+        fila->tamanho--;
+        if (fila->tamanho > 0) {
+            fila->heap[0] = fila->heap[fila->tamanho];
+            dario_descer(fila, 0);
+        }
+    } else {
+        chave = fila->raiz;
+        fila->raiz = pareamento_combinar(fila, fila->filho[chave]);
+        fila->tamanho--;
+    }
+
+    fila->pos[chave] = AUSENTE;
+
+    if (prioridade)
+        *prioridade = fila->prioridade[chave];
+
+    return chave;
+}
+
+int fila_prioridade_contem(fila_prioridade_t *fila, int chave)
+{
+    verifica_chave(fila, chave);
+
+    return fila->pos[chave] != AUSENTE;
+}
+
+int fila_prioridade_vazia(fila_prioridade_t *fila)
+{
+    if (fila == NULL) {
+        fprintf(stderr, "fila_prioridade_vazia: fila invalida\n");
+        exit(EXIT_FAILURE);
+    }
+
+    return fila->tamanho == 0;
+}
+
+int fila_prioridade_tamanho(fila_prioridade_t *fila)
+{
+    if (fila == NULL) {
+        fprintf(stderr, "fila_prioridade_tamanho: fila invalida\n");
+        exit(EXIT_FAILURE);
+    }
+
+    return fila->tamanho;
+}
+
+/**
+  * @brief  Esvazia a fila em O(tamanho), mantendo a memoria alocada
+  * @param  fila: fila de prioridade
+  *
+  * @retval Nenhum
+  */
+void fila_prioridade_limpar(fila_prioridade_t *fila)
+{
+    int n, chave, c;
+
+    if (fila == NULL) {
+        fprintf(stderr, "fila_prioridade_limpar: fila invalida\n");
+        exit(EXIT_FAILURE);
+    }
+
+    if (fila->tipo == HEAP_DARIO) {
+        for (n = 0; n < fila->tamanho; n++)
+            fila->pos[fila->heap[n]] = AUSENTE;
+    } else if (fila->raiz != AUSENTE) {
+        /* Percorre a arvore usando auxiliar como pilha */
+        n = 0;
+        fila->auxiliar[n++] = fila->raiz;
+        while (n > 0) {
+            chave = fila->auxiliar[--n];
+            fila->pos[chave] = AUSENTE;
+            for (c = fila->filho[chave]; c != AUSENTE; c = fila->irmao[c])
+                fila->auxiliar[n++] = c;
+        }
+    }
+
+    fila->tamanho = 0;
+    fila->raiz = AUSENTE;
+}
+
+void libera_fila_prioridade(fila_prioridade_t *fila)
+{
+    if (fila == NULL) {
+        fprintf(stderr, "libera_fila_prioridade: fila invalida\n");
+        exit(EXIT_FAILURE);
+    }
+
+    free(fila->prioridade);
+    free(fila->desempate);
+    free(fila->pos);
+    free(fila->heap);
+    free(fila->filho);
+    free(fila->irmao);
+    free(fila->anterior);
+    free(fila->auxiliar);
+    free(fila);
+}
@@ -0,0 +1,553 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "floyd_warshall.h"
+#include "paralelo.h"
+
+#define FALSE 0
+#define TRUE 1
+
+/* Compile com -DFLOYD_ESCALAR para usar apenas o kernel escalar */
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && !defined(FLOYD_ESCALAR)
+#include <immintrin.h>
+#define FLOYD_X86 1
+#endif
+
+/* Lado do bloco: tres blocos de 64 x 64 floats (48 KiB) cabem na L2 e as
+ * linhas de 256 bytes sao multiplas do vetor AVX */
+#define FLOYD_BLOCO 64
+
+/* Com poucos blocos por fase, criar threads custa mais que o calculo */
+#define FLOYD_BLOCOS_PARALELO 4
+
+/* Relaxa o bloco C = (i, j) pelos caminhos que passam pelo bloco k:
+ * C[ii][jj] = min(C[ii][jj], A[ii][kk] + B[kk][jj]), A = (i, k), B = (k, j).
+ * Com kk no laco externo, C pode coincidir com A ou B (fases 1 e 2) */
+typedef void (*kernel_t)(float *c, const float *a, const float *b, int largura);
+
+#ifndef FLOYD_X86
+static void kernel_escalar(float *c, const float *a, const float *b, int largura)
+{
+    const float *linha_b;
+    float aik, candidato;
+    int ii, jj, kk;
+
+    for (kk = 0; kk < FLOYD_BLOCO; kk++)
+    {
+        linha_b = b + (size_t)kk * largura;
+        for (ii = 0; ii < FLOYD_BLOCO; ii++)
+        {
+            aik = a[(size_t)ii * largura + kk];
+            if (aik == INFINITY)
+                continue;
+
+            for (jj = 0; jj < FLOYD_BLOCO; jj++)
+            {
+                candidato = aik + linha_b[jj];
+                if (candidato < c[(size_t)ii * largura + jj])
+                    c[(size_t)ii * largura + jj] = candidato;
+            }
+        }
+    }
+}
+
+#else
+static void kernel_sse2(float *c, const float *a, const float *b, int largura)
+{
+    __m128 va;
+    float *linha_c;
+    const float *linha_b;
+    float aik;
+    int ii, jj, kk;
+
+    for (kk = 0; kk < FLOYD_BLOCO; kk++)
+    {
+        linha_b = b + (size_t)kk * largura;
+        for (ii = 0; ii < FLOYD_BLOCO; ii++)
+        {
+            aik = a[(size_t)ii * largura + kk];
+            if (aik == INFINITY)
+                continue;
+
+            va = _mm_set1_ps(aik);
+            linha_c = c + (size_t)ii * largura;
+
+            for (jj = 0; jj < FLOYD_BLOCO; jj += 4)
+                _mm_store_ps(linha_c + jj, _mm_min_ps(_mm_load_ps(linha_c + jj),
+                                                      _mm_add_ps(va, _mm_load_ps(linha_b + jj))));
+        }
+    }
+}
+
+__attribute__((target("avx2")))
+static void kernel_avx2(float *c, const float *a, const float *b, int largura)
+{
+    __m256 va;
+    float *linha_c;
+    const float *linha_b;
+    float aik;
+    int ii, jj, kk;
+
+    for (kk = 0; kk < FLOYD_BLOCO; kk++)
+    {
+        linha_b = b + (size_t)kk * largura;
+        for (ii = 0; ii < FLOYD_BLOCO; ii++)
+        {
+            aik = a[(size_t)ii * largura + kk];
+            if (aik == INFINITY)
+                continue;
+
+            va = _mm256_set1_ps(aik);
+            linha_c = c + (size_t)ii * largura;
+
+            for (jj = 0; jj < FLOYD_BLOCO; jj += 8)
+                _mm256_store_ps(linha_c + jj,
+                                _mm256_min_ps(_mm256_load_ps(linha_c + jj),
+                                              _mm256_add_ps(va, _mm256_load_ps(linha_b + jj))));
+        }
+    }
+}
+#endif
+
+/* Melhor kernel suportado pelo processador em execucao */
+static kernel_t escolhe_kernel(void)
+{
+#ifdef FLOYD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+        return kernel_avx2;
+    return kernel_sse2;
+#else
+    return kernel_escalar;
+#endif
+}
+
+/* Passo do Dijkstra de proximos_alvo: relaxa as chaves pela aresta ate s,
+ * ja fixado a distancia dst do alvo, e retorna o nao fixado de menor chave
+ * (-1 se nenhum alcancavel). Fixados tem chave -INFINITY */
+typedef int (*passo_t)(float *chave, int *pai, const float *linha, float dst, int s, int n);
+
+static int passo_escalar(float *chave, int *pai, const float *linha, float dst, int s, int n)
+{
+    float candidato, menor = INFINITY;
+    int v, seguinte = -1;
+
+    for (v = 0; v < n; v++)
+    {
+        candidato = linha[v] + dst;
+        if (candidato < chave[v])
+        {
+            chave[v] = candidato;
+            pai[v] = s;
+        }
+        if (chave[v] >= 0 && chave[v] < menor)
+        {
+            menor = chave[v];
+            seguinte = v;
+        }
+    }
+
+    return seguinte;
+}
+
+#ifdef FLOYD_X86
+__attribute__((target("avx2")))
+static int passo_avx2(float *chave, int *pai, const float *linha, float dst, int s, int n)
+{
+    __m256 vdst = _mm256_set1_ps(dst), zero = _mm256_setzero_ps();
+    __m256 vmenor = _mm256_set1_ps(INFINITY), c, k, melhora;
+    __m256i vs = _mm256_set1_epi32(s), indices = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    __m256i oito = _mm256_set1_epi32(8), vseguinte = _mm256_set1_epi32(-1), p;
+    float menores[8], candidato, menor = INFINITY;
+    int seguintes[8], v, i, seguinte = -1;
+
+    for (v = 0; v + 8 <= n; v += 8)
+    {
+        c = _mm256_add_ps(_mm256_loadu_ps(linha + v), vdst);
+        k = _mm256_loadu_ps(chave + v);
+        melhora = _mm256_cmp_ps(c, k, _CMP_LT_OQ);
+        k = _mm256_blendv_ps(k, c, melhora);
+        _mm256_storeu_ps(chave + v, k);
+
+        p = _mm256_loadu_si256((__m256i *)(pai + v));
+        p = _mm256_castps_si256(_mm256_blendv_ps(_mm256_castsi256_ps(p),
+                                                 _mm256_castsi256_ps(vs), melhora));
+        _mm256_storeu_si256((__m256i *)(pai + v), p);
+
+        /* Menor chave nao fixada por posicao do vetor */
+        melhora = _mm256_and_ps(_mm256_cmp_ps(k, vmenor, _CMP_LT_OQ),
+                                _mm256_cmp_ps(k, zero, _CMP_GE_OQ));
+        vmenor = _mm256_blendv_ps(vmenor, k, melhora);
+        vseguinte = _mm256_castps_si256(_mm256_blendv_ps(_mm256_castsi256_ps(vseguinte),
+                                                         _mm256_castsi256_ps(indices), melhora));
+        indices = _mm256_add_epi32(indices, oito);
+    }
+
+    _mm256_storeu_ps(menores, vmenor);
+    _mm256_storeu_si256((__m256i *)seguintes, vseguinte);
+    for (i = 0; i < 8; i++)
+        if (menores[i] < menor)
+        {
+            menor = menores[i];
+            seguinte = seguintes[i];
+        }
+
+    for (; v < n; v++)
+    {
+        candidato = linha[v] + dst;
+        if (candidato < chave[v])
+        {
+            chave[v] = candidato;
+            pai[v] = s;
+        }
+        if (chave[v] >= 0 && chave[v] < menor)
+        {
+            menor = chave[v];
+            seguinte = v;
+        }
+    }
+
+    return seguinte;
+}
+#endif
+
+/* Passo AVX2 se o processador em execucao suportar */
+static passo_t escolhe_passo(void)
+{
+#ifdef FLOYD_X86
+    if (__builtin_cpu_supports("avx2"))
+        return passo_avx2;
+#endif
+    return passo_escalar;
+}
+
+typedef struct floyd
+{
+    float *d;                   /*!< Distancias, largura x largura */
+    int largura;                /*!< n arredondado para multiplo do bloco */
+    int blocos;                 /*!< largura / FLOYD_BLOCO */
+    int k;                      /*!< Bloco pivo da rodada */
+    kernel_t kernel;
+
+    /* Montagem dos proximos */
+    passo_t passo;
+    grafo_matriz_t *matriz;
+    int n;
+    int *proximo;               /*!< Saida do chamador, n x n */
+} floyd_t;
+
+static void relaxa(floyd_t *f, int i, int j)
+{
+    size_t l = f->largura, B = FLOYD_BLOCO;
+
+    f->kernel(f->d + i * B * l + j * B, f->d + i * B * l + f->k * B,
+              f->d + f->k * B * l + j * B, f->largura);
+}
+
+/* Fase 2: blocos da linha e da coluna do pivo */
+static void fase_cruz(void *contexto, int t)
+{
+    floyd_t *f = contexto;
+    int outro = t / 2 < f->k ? t / 2 : t / 2 + 1;
+
+    if (t % 2 == 0)
+        relaxa(f, f->k, outro);
+    else
+        relaxa(f, outro, f->k);
+}
+
+/* Fase 3: demais blocos, uma linha de blocos por tarefa */
+static void fase_restante(void *contexto, int t)
+{
+    floyd_t *f = contexto;
+    int i = t < f->k ? t : t + 1, j;
+
+    for (j = 0; j < f->blocos; j++)
+        if (j != f->k)
+            relaxa(f, i, j);
+}
+
+static void *aloca(size_t tamanho)
+{
+    void *p = malloc(tamanho);
+
+    if (p == NULL)
+    {
+        perror("floyd_warshall_matriz:");
+        exit(EXIT_FAILURE);
+    }
+
+    return p;
+}
+
+/* Proximos ate o alvo t: um Dijkstra a partir de t em que a chave de v e
+ * min w(v, z) + d(z, t) sobre os z ja fixados, com as distancias finais.
+ * Cada vertice aponta para um fixado antes dele, entao nao ha lacos mesmo
+ * com empates (arestas de peso zero) ou arredondamento */
+static void proximos_alvo(void *contexto, int t)
+{
+    floyd_t *f = contexto;
+    size_t l = f->largura;
+    int *pai, n = f->n, v, s;
+    float *chave;
+
+    chave = aloca(n * sizeof(float));
+    pai = aloca(n * sizeof(int));
+
+    for (v = 0; v < n; v++)
+    {
+        chave[v] = INFINITY;
+        pai[v] = -1;
+    }
+    pai[t] = t;
+
+    /* Matriz simetrica: a linha de s da w(v, s) */
+    for (s = t; s != -1;)
+    {
+        chave[s] = -INFINITY;
+        s = f->passo(chave, pai, matriz_linha(f->matriz, s), f->d[s * l + t], s, n);
+    }
+
+    for (v = 0; v < n; v++)
+        f->proximo[(size_t)v * n + t] = pai[v];
+
+    free(chave);
+    free(pai);
+}
+
+/**
+  * @brief  Floyd-Warshall sequencial, sem blocos nem vetorização
+  * @param	matriz: grafo denso
+  * @param  dist, proximo: saídas n x n do chamador (proximo pode ser NULL)
+  *
+  * Referência para conferir floyd_warshall_matriz: pivôs em ordem, e o
+  * próximo só muda quando a distância diminui estritamente.
+  *
+  * @retval Nenhum
+  */
+void floyd_warshall_simples(grafo_matriz_t *matriz, float *dist, int *proximo)
+{
+    const float *linha;
+    float duk, candidato;
+    int n, u, v, k;
+
+    if (matriz == NULL || dist == NULL)
+    {
+        fprintf(stderr, "floyd_warshall_simples: parametros invalidos\n");
+        exit(EXIT_FAILURE);
+    }
+
+    n = matriz_num_vertices(matriz);
+    for (u = 0; u < n; u++)
+    {
+        linha = matriz_linha(matriz, u);
+        for (v = 0; v < n; v++)
+        {
+            dist[(size_t)u * n + v] = u == v ? 0 : linha[v];
+            if (proximo)
+                proximo[(size_t)u * n + v] = dist[(size_t)u * n + v] == INFINITY ? -1 : v;
+        }
+    }
+
+    for (k = 0; k < n; k++)
+        for (u = 0; u < n; u++)
+        {
+            duk = dist[(size_t)u * n + k];
+            if (duk == INFINITY)
+                continue;
+
+            for (v = 0; v < n; v++)
+            {
+                candidato = duk + dist[(size_t)k * n + v];
+                if (candidato < dist[(size_t)u * n + v])
+                {
+                    dist[(size_t)u * n + v] = candidato;
+                    if (proximo)
+                        proximo[(size_t)u * n + v] = proximo[(size_t)u * n + k];
+                }
+            }
+        }
+}
+
+/**
+  * @brief  Floyd-Warshall em blocos
+  * @param	matriz: grafo denso
+  * @param  dist, proximo: saídas n x n do chamador
+  * @param  num_threads: número de threads (0: uma por núcleo)
+  *
+  * A matriz é completada até múltiplo de FLOYD_BLOCO com INFINITY. Para
+  * cada bloco pivô k: (1) o bloco (k, k); (2) em paralelo, os blocos da
+  * linha e da coluna k; (3) em paralelo, os demais. Cada bloco é relaxado
+  * pelo kernel min-plus AVX2, SSE2 ou escalar, escolhido em tempo de
+  * execução.
+  *
+  * Os próximos não acompanham os blocos: na fase 3 a coluna do pivô já
+  * passou pelos pivôs seguintes do mesmo bloco, e empates em arestas de
+  * peso zero fechariam laços. Eles são montados depois, das distâncias
+  * finais, por um Dijkstra O(n^2) por alvo (proximos_alvo): cada vértice
+  * aponta para um vizinho fixado antes dele.
+  *
+  * @retval Nenhum
+  */
+void floyd_warshall_matriz(grafo_matriz_t *matriz, float *dist, int *proximo, int num_threads)
+{
+    floyd_t f;
+    const float *linha;
+    size_t total;
+    int n, u, v, threads;
+
+    if (matriz == NULL || dist == NULL || num_threads < 0)
+    {
+        fprintf(stderr, "floyd_warshall_matriz: parametros invalidos\n");
+        exit(EXIT_FAILURE);
+    }
+
+    n = matriz_num_vertices(matriz);
+    if (n == 0)
+        return;
+
+    if (num_threads == 0)
+        num_threads = paralelo_num_threads();
+
+    f.blocos = (n + FLOYD_BLOCO - 1) / FLOYD_BLOCO;
+    f.largura = f.blocos * FLOYD_BLOCO;
+    f.kernel = escolhe_kernel();
+
+    /* Linhas de FLOYD_BLOCO floats: o tamanho e multiplo do alinhamento */
+    total = (size_t)f.largura * f.largura;
+    f.d = aligned_alloc(32, total * sizeof(float));
+    if (f.d == NULL)
+    {
+        perror("floyd_warshall_matriz:");
+        exit(EXIT_FAILURE);
+    }
+
+    for (u = 0; u < f.largura; u++)
+    {
+        linha = u < n ? matriz_linha(matriz, u) : NULL;
+        for (v = 0; v < f.largura; v++)
+            f.d[(size_t)u * f.largura + v] = u == v ? 0 :
+                (linha && v < n ? linha[v] : INFINITY);
+    }
+
+    threads = f.blocos >= FLOYD_BLOCOS_PARALELO ? num_threads : 1;
+
+    for (f.k = 0; f.k < f.blocos; f.k++)
+    {
+        relaxa(&f, f.k, f.k);
+        paralelo_executa(threads, 2 * (f.blocos - 1), fase_cruz, &f);
+        paralelo_executa(threads, f.blocos - 1, fase_restante, &f);
+    }
+
+    if (proximo)
+    {
+        f.matriz = matriz;
+        f.n = n;
+        f.proximo = proximo;
+        f.passo = escolhe_passo();
+        paralelo_executa(threads, n, proximos_alvo, &f);
+    }
+
+    for (u = 0; u < n; u++)
+        memcpy(dist + (size_t)u * n, f.d + (size_t)u * f.largura, n * sizeof(float));
+
+    free(f.d);
+}
+
+/**
+  * @brief  Confere floyd_warshall_matriz com floyd_warshall_simples
+  * @param	matriz: grafo denso
+  * @param  num_threads: número de threads (0: uma por núcleo)
+  *
+  * As distâncias devem coincidir a menos de arredondamento, pois a ordem
+  * das somas difere, e todo par alcançável deve ter caminho sem laço cujo
+  * custo é a distância.
+  *
+  * @retval int: TRUE se conferiu, FALSE (com o par em stderr) se não
+  */
+int floyd_warshall_confere(grafo_matriz_t *matriz, int num_threads)
+{
+    int n, u, v, w, tamanho, *proximo, *caminho, certo = TRUE;
+    float *dist, *referencia, custo, tolerancia;
+
+    if (matriz == NULL)
+    {
+        fprintf(stderr, "floyd_warshall_confere: parametros invalidos\n");
+        exit(EXIT_FAILURE);
+    }
+
+    n = matriz_num_vertices(matriz);
+    if (n == 0)
+        return TRUE;
+
+    dist = aloca((size_t)n * n * sizeof(float));
+    referencia = aloca((size_t)n * n * sizeof(float));
+    proximo = aloca((size_t)n * n * sizeof(int));
+    caminho = aloca(n * sizeof(int));
+
+    floyd_warshall_matriz(matriz, dist, proximo, num_threads);
+    floyd_warshall_simples(matriz, referencia, NULL);
+
+    for (u = 0; u < n && certo; u++)
+        for (v = 0; v < n && certo; v++)
+        {
+            if (referencia[(size_t)u * n + v] == INFINITY)
+            {
+                certo = dist[(size_t)u * n + v] == INFINITY &&
+                        floyd_caminho(proximo, n, u, v, NULL, 0) == 0;
+            }
+            else
+            {
+                tolerancia = 1e-4f * (1 + referencia[(size_t)u * n + v]);
+                tamanho = floyd_caminho(proximo, n, u, v, caminho, n);
+                for (w = 1, custo = 0; w < tamanho; w++)
+                    custo += matriz_get_peso(matriz, caminho[w - 1], caminho[w]);
+
+                certo = fabsf(dist[(size_t)u * n + v] - referencia[(size_t)u * n + v]) <= tolerancia &&
+                        tamanho > 0 && fabsf(custo - dist[(size_t)u * n + v]) <= tolerancia;
+            }
+
+            if (!certo)
+                fprintf(stderr, "floyd_warshall_confere: par (%d, %d) difere da versao sequencial\n",
+                        u, v);
+        }
+
+    free(dist);
+    free(referencia);
+    free(proximo);
+    free(caminho);
+
+    return certo;
+}
+
+int floyd_caminho(const int *proximo, int n, int u, int v, int *caminho, int max)
+{
+    int tamanho, w;
+
+    if (proximo == NULL || u < 0 || v < 0 || u >= n || v >= n)
+    {
+        fprintf(stderr, "floyd_caminho: parametros invalidos\n");
+        exit(EXIT_FAILURE);
+    }
+
+    if (proximo[(size_t)u * n + v] == -1)
+        return 0;
+
+    /* Um caminho simples tem no maximo n vertices */
+    tamanho = 1;
+    for (w = u; w != v; w = proximo[(size_t)w * n + v])
+        if (w < 0 || ++tamanho > n)
+            return -1;
+
+    if (tamanho > max || caminho == NULL)
+        return tamanho;
+
+    tamanho = 0;
+    for (w = u; w != v; w = proximo[(size_t)w * n + v])
+        caminho[tamanho++] = w;
+    caminho[tamanho++] = v;
+
+    return tamanho;
+}
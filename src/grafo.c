@@ -10,14 +10,24 @@
 #include <stdarg.h>
 #include "grafo.h"
 #include "fila.h"
+#include "tabela_hash.h"
 
 #define FALSE 0
 #define TRUE 1
 
+#define CAPACIDADE_INICIAL 16
+#define OBJETOS_POR_SLAB 1024
+
 struct grafos
 {
     int id;                    /*!< Identificação numérica do grafo  */
     lista_enc_t *vertices;     /*!< Lista encadeada dos vértices: conjunto V  */
+    tabela_hash_t *indices;    /*!< id do vértice -> índice denso */
+    vertice_t **vetor;         /*!< índice denso -> vértice */
+    int capacidade;            /*!< Capacidade alocada de vetor */
+    arena_t *arena;            /*!< Vértices, listas, nomes, nós e arestas */
+    pool_t *pool_nos;          /*!< Slabs de no_t */
+    pool_t *pool_arestas;      /*!< Slabs de arestas_t: arestas contíguas */
 };
 
 /**
@@ -39,7 +49,19 @@ grafo_t *cria_grafo(int id)
     }
 
     p->id = id;
-    p->vertices = cria_lista_enc();
+    p->arena = cria_arena(0);
+    p->pool_nos = cria_pool(p->arena, tamanho_no(), OBJETOS_POR_SLAB);
+    p->pool_arestas = cria_pool(p->arena, tamanho_aresta(), OBJETOS_POR_SLAB);
+    p->vertices = cria_lista_enc_arena(p->arena);
+    p->indices = cria_tabela_hash(CAPACIDADE_INICIAL);
+    p->capacidade = CAPACIDADE_INICIAL;
+    p->vetor = malloc(p->capacidade * sizeof(vertice_t*));
+
+    if (p->vetor == NULL)
+    {
+        perror("cria_grafo:");
+        exit(EXIT_FAILURE);
+    }
 
     return p;
 }
@@ -48,6 +70,24 @@ int numero_vertices(grafo_t *grafo) {
   return tamanho_lista(grafo->vertices);
 }
 
+/**
+  * @brief  Obtém um vértice pelo índice denso
+  * @param	grafo: ponteiro do grafo
+  * @param  indice: índice em [0, numero_vertices)
+  *
+  * @retval vertice_t: ponteiro do vértice
+  */
+vertice_t* grafo_get_vertice(grafo_t *grafo, int indice)
+{
+    if (grafo == NULL || indice < 0 || indice >= numero_vertices(grafo))
+    {
+        fprintf(stderr, "grafo_get_vertice: indice invalido\n");
+        exit(EXIT_FAILURE);
+    }
+
+    return grafo->vetor[indice];
+}
+
 /**
   * @brief  Adicionar um vértice no grafo (conjunto V)
   * @param	grafo: ponteiro do grafo que se deseja adicionar um vértice
@@ -59,6 +99,7 @@ vertice_t* grafo_adicionar_vertice(grafo_t *grafo, int id)
 {
     vertice_t *vertice;
     no_t *no;
+    int indice;
 
 #ifdef DEBUG
     printf("grafo_adicionar_vertice: %d\n", id);
@@ -76,16 +117,31 @@ vertice_t* grafo_adicionar_vertice(grafo_t *grafo, int id)
         exit(EXIT_FAILURE);
     }
 
-    vertice = cria_vertice(id);
-    no = cria_no(vertice);
+    indice = numero_vertices(grafo);
+    if (indice == grafo->capacidade)
+    {
+        grafo->capacidade *= 2;
+        grafo->vetor = realloc(grafo->vetor, grafo->capacidade * sizeof(vertice_t*));
+        if (grafo->vetor == NULL)
+        {
+            perror("grafo_adicionar_vertice:");
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    vertice = cria_vertice_arena(grafo->arena, grafo->pool_nos, id);
+    vertice_set_indice(vertice, indice);
+    no = cria_no_pool(grafo->pool_nos, vertice);
 
     add_cauda(grafo->vertices, no);
+    grafo->vetor[indice] = vertice;
+    tabela_hash_inserir(grafo->indices, id, indice);
 
     return vertice;
 }
 
 /**
-  * @brief  Procura um vértice com id específico no grafo
+  * @brief  Procura um vértice com id específico no grafo. O(1) pela tabela hash
   * @param	grafo: ponteiro do grafo que se deseja busca o vértice
   * @param  id: identificação da aresta
   *
@@ -93,9 +149,7 @@ vertice_t* grafo_adicionar_vertice(grafo_t *grafo, int id)
   */
 vertice_t* procura_vertice(grafo_t *grafo, int id)
 {
-    no_t *no_lista;
-    vertice_t *vertice;
-    int meu_id;
+    int indice;
 
     if (grafo == NULL)
     {
@@ -103,28 +157,11 @@ vertice_t* procura_vertice(grafo_t *grafo, int id)
         exit(EXIT_FAILURE);
     }
 
-    if (lista_vazia(grafo->vertices) == TRUE)
-        return FALSE;
-
-    no_lista = obter_cabeca(grafo->vertices);
+    indice = tabela_hash_buscar(grafo->indices, id);
+    if (indice == HASH_AUSENTE)
+        return NULL;
 
-    while (no_lista)
-    {
-        //obtem o endereco da lista
-        vertice = obter_dado(no_lista);
-
-        //obterm o id do vertice
-        meu_id = vertice_get_id(vertice);
-
-        if (meu_id == id)
-        {
-            return vertice;
-        }
-
-        no_lista = obtem_proximo(no_lista);
-    }
-
-    return NULL;
+    return grafo->vetor[indice];
 }
 
 /**
@@ -166,8 +203,8 @@ void adiciona_adjacentes(grafo_t *grafo, vertice_t *vertice, int n, ...)
             exit(EXIT_FAILURE);
         }
 
-        aresta = cria_aresta(vertice, sucessor,peso);
-        contra_aresta = cria_aresta(sucessor, vertice, peso);
+        aresta = cria_aresta_pool(grafo->pool_arestas, vertice, sucessor, peso);
+        contra_aresta = cria_aresta_pool(grafo->pool_arestas, sucessor, vertice, peso);
         adiciona_aresta(vertice, aresta);
         adiciona_aresta(sucessor, contra_aresta);
 
@@ -182,6 +219,58 @@ void adiciona_adjacentes(grafo_t *grafo, vertice_t *vertice, int n, ...)
     va_end (argumentos);
 }
 
+/**
+  * @brief  Cria uma única aresta dirigida fonte -> destino
+  * @param	grafo: grafo que contém os dois vértices
+  * @param  fonte: vértice de origem
+  * @param  destino: vértice de chegada
+  * @param  peso: peso da aresta
+  *
+  * Ao contrário de adiciona_adjacentes, a contra-aresta não é criada:
+  * usado para tabelas de tempos assimétricas.
+  *
+  * @retval Nenhum
+  */
+void adiciona_arco(grafo_t *grafo, vertice_t *fonte, vertice_t *destino, float peso)
+{
+    if (grafo == NULL || fonte == NULL || destino == NULL)
+    {
+        fprintf(stderr, "adiciona_arco: parametros invalidos\n");
+        exit(EXIT_FAILURE);
+    }
+
+    adiciona_aresta(fonte, cria_aresta_pool(grafo->pool_arestas, fonte, destino, peso));
+}
+
+/**
+  * @brief  Nomeia um vértice com uma cópia do nome na memória do grafo
+  * @param	grafo: grafo que contém o vértice
+  * @param  vertice: vértice a ser nomeado
+  * @param  nome: nome a ser copiado. Pode ser NULL
+  *
+  * @retval Nenhum
+  */
+void grafo_set_nome(grafo_t *grafo, vertice_t *vertice, const char *nome)
+{
+    if (grafo == NULL)
+    {
+        fprintf(stderr, "grafo_set_nome: grafo invalido\n");
+        exit(EXIT_FAILURE);
+    }
+
+    vertice_set_nome(vertice, arena_copia_string(grafo->arena, nome));
+}
+
+/**
+  * @brief  Copia uma aresta de outro grafo para este grafo.
+  * @param	grafo: grafo destino (ex.: arvore geradora)
+  * @param  aresta: aresta de outro grafo
+  *
+  * Os vértices são criados no grafo destino caso não existam. A aresta e os
+  * nomes são copiados: o grafo destino não compartilha memória com a origem.
+  *
+  * @retval Nenhum
+  */
 void adiciona_aresta_grafo(grafo_t *grafo, arestas_t *aresta) {
     vertice_t *fonte, *destino;
     int id_fonte, id_destino;
@@ -190,20 +279,18 @@ void adiciona_aresta_grafo(grafo_t *grafo, arestas_t *aresta) {
     fonte = procura_vertice(grafo, id_fonte);
     if (fonte == NULL) {
       fonte = grafo_adicionar_vertice(grafo, id_fonte);
-      vertice_visitado(fonte, TRUE);
+      grafo_set_nome(grafo, fonte, vertice_get_nome(aresta_get_fonte(aresta)));
     }
 
     id_destino = vertice_get_id(aresta_get_adjacente(aresta));
     destino = procura_vertice(grafo, id_destino);
     if (destino == NULL) {
       destino = grafo_adicionar_vertice(grafo, id_destino);
-      vertice_visitado(destino, FALSE);
+      grafo_set_nome(grafo, destino, vertice_get_nome(aresta_get_adjacente(aresta)));
     }
 
-    vertice_set_nome(fonte, vertice_get_nome(aresta_get_fonte(aresta)));
-    vertice_set_nome(destino, vertice_get_nome(aresta_get_adjacente(aresta)));
-
-    adiciona_aresta(fonte, aresta);
+    adiciona_aresta(fonte, cria_aresta_pool(grafo->pool_arestas, fonte, destino,
+                                            aresta_get_peso(aresta)));
 
 #ifdef DEBUG
     printf("\tfonte: %d\n", id_fonte);
@@ -296,67 +383,26 @@ void exportar_grafo_dot(const char *filename, grafo_t *grafo)
     fclose(file);
 }
 
-lista_enc_t* componentes_conexos(grafo_t *grafo)
-{
-  return grafo->vertices;
-}
-
 /**
   * @brief  Libera a memória utilizada pelo grafo
   * @param  grafo: ponteiro do grafo a ser exportado
   *
+  * Vértices, arestas, listas e nomes copiados por grafo_set_nome estão na
+  * arena do grafo e são liberados em bloco. Nomes atribuídos diretamente com
+  * vertice_set_nome pertencem ao chamador.
+  *
   * @retval Nenhum
   */
 void libera_grafo (grafo_t *grafo)
 {
-    no_t *no_vert;
-    no_t *no_arest;
-    no_t *no_liberado;
-    vertice_t *vertice;
-    arestas_t *aresta;
-    lista_enc_t *lista_arestas;
-
     if (grafo == NULL)
     {
         fprintf(stderr, "libera_grafo: grafo invalido\n");
         exit(EXIT_FAILURE);
     }
 
-    //varre todos os vertices
-    no_vert = obter_cabeca(grafo->vertices);
-    while (no_vert)
-    {
-        vertice = obter_dado(no_vert);
-
-        //libera todas as arestas
-        lista_arestas = vertice_get_arestas(vertice);
-        no_arest = obter_cabeca(lista_arestas);
-        while (no_arest)
-        {
-            aresta = obter_dado(no_arest);
-
-            //libera aresta
-            free(aresta);
-
-            //libera no da lsita
-            no_liberado = no_arest;
-            no_arest = obtem_proximo(no_arest);
-            free(no_liberado);
-        }
-
-        //libera lista de arestas e vertice
-        free(lista_arestas);
-        if(vertice_get_nome(vertice))
-          free(vertice_get_nome(vertice));
-        free(vertice);
-
-        //libera no da lista
-        no_liberado = no_vert;
-        no_vert = obtem_proximo(no_vert);
-        free(no_liberado);
-    }
-
-    //libera grafo e vertice
-    free(grafo->vertices);
+    libera_tabela_hash(grafo->indices);
+    free(grafo->vetor);
+    libera_arena(grafo->arena);
     free(grafo);
 }
@@ -0,0 +1,626 @@
+/*
+ * grafo_csr.c
+ *
+ * Fotografia imutavel de grafo_t em vetores planos.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <stdint.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "grafo_csr.h"
+#include "tabela_hash.h"
+
+#define FALSE 0
+#define TRUE 1
+
+struct grafos_csr
+{
+    int n;                  /*!< Numero de vertices */
+    int m;                  /*!< Numero de arestas (direcionadas) */
+    int *ids;               /*!< Identificacao de cada vertice */
+    int *offsets;           /*!< Inicio das arestas de cada vertice: n + 1 */
+    int *vizinhos;          /*!< Indice denso do destino de cada aresta */
+    float *pesos;           /*!< Peso de cada aresta, paralelo a vizinhos */
+    int *pesos_inteiros;    /*!< Copia inteira de pesos. NULL se algum peso nao for inteiro */
+    int peso_maximo;        /*!< Maior peso inteiro */
+    int *nome_offsets;      /*!< Inicio do nome de cada vertice em nomes. -1 se sem nome */
+    char *nomes;            /*!< Tabela de strings terminadas em '\0' */
+    tabela_hash_t *indices; /*!< id -> indice denso. NULL se mapeado */
+
+    const int32_t *por_id;  /*!< Pares (id, indice) em ordem de id, se mapeado */
+    void *mapa;             /*!< Regiao de mmap, NULL se em malloc */
+    size_t tamanho_mapa;
+};
+
+#define CSR_MAGICO "GTCSR"
+#define CSR_VERSAO 1
+#define CSR_ORDEM 0x01020304u
+
+/* Cabecalho da fotografia em arquivo. Cada secao comeca em um deslocamento
+ * multiplo de 8, na ordem: ids, offsets, vizinhos, pesos, pesos inteiros
+ * (se houver), inicio dos nomes, pares (id, indice) ordenados por id e a
+ * tabela de nomes. Inteiros de 32 bits little-endian */
+typedef struct cabecalho_csr
+{
+    char magico[8];
+    uint32_t versao;
+    uint32_t ordem;             /*!< CSR_ORDEM, para detectar a ordem dos bytes */
+    int32_t n;
+    int32_t m;
+    int32_t pesos_inteiros;     /*!< Ha secao de pesos inteiros */
+    int32_t peso_maximo;
+    uint64_t tamanho_nomes;
+} cabecalho_csr_t;
+
+/* Deslocamento de cada secao no arquivo */
+typedef struct secoes_csr
+{
+    size_t ids;
+    size_t offsets;
+    size_t vizinhos;
+    size_t pesos;
+    size_t pesos_inteiros;
+    size_t nome_offsets;
+    size_t por_id;
+    size_t nomes;
+    size_t fim;
+} secoes_csr_t;
+
+static void *aloca(size_t tamanho)
+{
+    void *p = malloc(tamanho > 0 ? tamanho : 1);
+
+    if (p == NULL)
+    {
+        perror("cria_grafo_csr:");
+        exit(EXIT_FAILURE);
+    }
+
+    return p;
+}
+
+/* Maior peso exato em float: acima disso nem todo inteiro e representavel */
+#define PESO_INTEIRO_MAXIMO (1 << 24)
+
+/* Preenche pesos_inteiros se todos os pesos forem inteiros nao negativos e
+ * nenhuma distancia relaxada (caminho simples mais uma aresta) puder
+ * ultrapassar INT_MAX */
+static void calcula_pesos_inteiros(grafo_csr_t *csr)
+{
+    int k, maximo = 0;
+
+    csr->pesos_inteiros = NULL;
+    csr->peso_maximo = 0;
+
+    for (k = 0; k < csr->m; k++)
+    {
+        if (!(csr->pesos[k] >= 0 && csr->pesos[k] <= PESO_INTEIRO_MAXIMO) ||
+            csr->pesos[k] != (float) (int) csr->pesos[k])
+            return;
+        if ((int) csr->pesos[k] > maximo)
+            maximo = (int) csr->pesos[k];
+    }
+
+    if ((long long) maximo * csr->n > INT_MAX)
+        return;
+
+    csr->pesos_inteiros = aloca(csr->m * sizeof(int));
+    for (k = 0; k < csr->m; k++)
+        csr->pesos_inteiros[k] = (int) csr->pesos[k];
+    csr->peso_maximo = maximo;
+}
+
+/**
+  * @brief  Cria a fotografia CSR de um grafo
+  * @param	grafo: grafo de origem
+  *
+  * Os graus são obtidos do tamanho das listas de arestas, de modo que as
+  * arestas são copiadas diretamente para a posição final em uma única passada.
+  *
+  * @retval grafo_csr_t: nova fotografia, independente do grafo de origem
+  */
+grafo_csr_t *cria_grafo_csr(grafo_t *grafo)
+{
+    grafo_csr_t *csr;
+    vertice_t *v;
+    arestas_t *aresta;
+    no_t *no;
+    char *nome;
+    int i, k, tamanho_nomes = 0;
+
+    if (grafo == NULL)
+    {
+        fprintf(stderr, "cria_grafo_csr: grafo invalido\n");
+        exit(EXIT_FAILURE);
+    }
+
+    csr = aloca(sizeof(grafo_csr_t));
+    csr->n = numero_vertices(grafo);
+    csr->ids = aloca(csr->n * sizeof(int));
+    csr->offsets = aloca((csr->n + 1) * sizeof(int));
+    csr->nome_offsets = aloca(csr->n * sizeof(int));
+    csr->indices = cria_tabela_hash(csr->n);
+    csr->por_id = NULL;
+    csr->mapa = NULL;
+
+    csr->offsets[0] = 0;
+    for (i = 0; i < csr->n; i++)
+    {
+        v = grafo_get_vertice(grafo, i);
+        csr->offsets[i + 1] = csr->offsets[i] + tamanho_lista(vertice_get_arestas(v));
+
+        nome = vertice_get_nome(v);
+        csr->nome_offsets[i] = nome ? tamanho_nomes : -1;
+        if (nome)
+            tamanho_nomes += strlen(nome) + 1;
+    }
+
+    csr->m = csr->offsets[csr->n];
+    csr->vizinhos = aloca(csr->m * sizeof(int));
+    csr->pesos = aloca(csr->m * sizeof(float));
+    csr->nomes = aloca(tamanho_nomes);
+
+    for (i = 0; i < csr->n; i++)
+    {
+        v = grafo_get_vertice(grafo, i);
+        csr->ids[i] = vertice_get_id(v);
+        tabela_hash_inserir(csr->indices, csr->ids[i], i);
+
+        if (csr->nome_offsets[i] >= 0)
+            strcpy(csr->nomes + csr->nome_offsets[i], vertice_get_nome(v));
+
+        k = csr->offsets[i];
+        for (no = obter_cabeca(vertice_get_arestas(v)); no; no = obtem_proximo(no))
+        {
+            aresta = obter_dado(no);
+            csr->vizinhos[k] = vertice_get_indice(aresta_get_adjacente(aresta));
+            csr->pesos[k] = aresta_get_peso(aresta);
+            k++;
+        }
+    }
+
+    calcula_pesos_inteiros(csr);
+
+    return csr;
+}
+
+/**
+  * @brief  Cria a fotografia com todas as arestas invertidas
+  * @param	csr: fotografia de origem
+  *
+  * As arestas de entrada de cada vértice passam a ser as de saída, o que
+  * permite percorrer predecessores (ex.: BFS de baixo para cima, Dijkstra
+  * reverso) em grafos direcionados. Índices, ids e nomes são os mesmos.
+  *
+  * @retval grafo_csr_t: nova fotografia, independente da origem
+  */
+grafo_csr_t *cria_grafo_csr_transposto(grafo_csr_t *csr)
+{
+    grafo_csr_t *t;
+    int i, k, w, *posicao, tamanho_nomes = 0;
+
+    if (csr == NULL)
+    {
+        fprintf(stderr, "cria_grafo_csr_transposto: grafo invalido\n");
+        exit(EXIT_FAILURE);
+    }
+
+    for (i = 0; i < csr->n; i++)
+        if (csr->nome_offsets[i] >= 0)
+            tamanho_nomes = csr->nome_offsets[i] + strlen(csr->nomes + csr->nome_offsets[i]) + 1;
+
+    t = aloca(sizeof(grafo_csr_t));
+    t->n = csr->n;
+    t->m = csr->m;
+    t->ids = aloca(t->n * sizeof(int));
+    t->offsets = aloca((t->n + 1) * sizeof(int));
+    t->vizinhos = aloca(t->m * sizeof(int));
+    t->pesos = aloca(t->m * sizeof(float));
+    t->nome_offsets = aloca(t->n * sizeof(int));
+    t->nomes = aloca(tamanho_nomes);
+    t->indices = cria_tabela_hash(t->n);
+    t->por_id = NULL;
+    t->mapa = NULL;
+
+    memcpy(t->ids, csr->ids, t->n * sizeof(int));
+    memcpy(t->nome_offsets, csr->nome_offsets, t->n * sizeof(int));
+    memcpy(t->nomes, csr->nomes, tamanho_nomes);
+    for (i = 0; i < t->n; i++)
+        tabela_hash_inserir(t->indices, t->ids[i], i);
+
+    /* Contagem dos graus de entrada */
+    for (i = 0; i <= t->n; i++)
+        t->offsets[i] = 0;
+    for (k = 0; k < csr->m; k++)
+        t->offsets[csr->vizinhos[k] + 1]++;
+    for (i = 0; i < t->n; i++)
+        t->offsets[i + 1] += t->offsets[i];
+
+    posicao = aloca(t->n * sizeof(int));
+    memcpy(posicao, t->offsets, t->n * sizeof(int));
+
+    for (i = 0; i < csr->n; i++)
+        for (k = csr->offsets[i]; k < csr->offsets[i + 1]; k++)
+        {
+            w = csr->vizinhos[k];
+            t->vizinhos[posicao[w]] = i;
+            t->pesos[posicao[w]] = csr->pesos[k];
+            posicao[w]++;
+        }
+
+    free(posicao);
+
+    calcula_pesos_inteiros(t);
+
+    return t;
+}
+
+void libera_grafo_csr(grafo_csr_t *csr)
+{
+    if (csr == NULL)
+    {
+        fprintf(stderr, "libera_grafo_csr: grafo invalido\n");
+        exit(EXIT_FAILURE);
+    }
+
+    if (csr->mapa)
+    {
+        munmap(csr->mapa, csr->tamanho_mapa);
+        free(csr);
+        return;
+    }
+
+    libera_tabela_hash(csr->indices);
+    free(csr->ids);
+    free(csr->offsets);
+    free(csr->vizinhos);
+    free(csr->pesos);
+    free(csr->pesos_inteiros);
+    free(csr->nome_offsets);
+    free(csr->nomes);
+    free(csr);
+}
+
+static size_t alinha(size_t deslocamento)
+{
+    return (deslocamento + 7) & ~(size_t)7;
+}
+
+static void calcula_secoes(const cabecalho_csr_t *c, secoes_csr_t *s)
+{
+    size_t n = c->n, m = c->m;
+
+    s->ids = alinha(sizeof(cabecalho_csr_t));
+    s->offsets = alinha(s->ids + n * sizeof(int32_t));
+    s->vizinhos = alinha(s->offsets + (n + 1) * sizeof(int32_t));
+    s->pesos = alinha(s->vizinhos + m * sizeof(int32_t));
+    s->pesos_inteiros = alinha(s->pesos + m * sizeof(float));
+    s->nome_offsets = alinha(s->pesos_inteiros + (c->pesos_inteiros ? m * sizeof(int32_t) : 0));
+    s->por_id = alinha(s->nome_offsets + n * sizeof(int32_t));
+    s->nomes = alinha(s->por_id + 2 * n * sizeof(int32_t));
+    s->fim = s->nomes + c->tamanho_nomes;
+}
+
+/* O formato e little-endian e mapeado sem conversao */
+static int little_endian(void)
+{
+    const uint32_t um = 1;
+
+    return *(const unsigned char *)&um == 1;
+}
+
+/* Completa com zeros ate inicio e grava a secao. FALSE em erro */
+static int escreve_secao(FILE *fp, size_t *posicao, size_t inicio,
+                         const void *dados, size_t tamanho)
+{
+    for (; *posicao < inicio; (*posicao)++)
+        if (fputc(0, fp) == EOF)
+            return FALSE;
+
+    if (tamanho > 0 && fwrite(dados, 1, tamanho, fp) != tamanho)
+        return FALSE;
+
+    *posicao += tamanho;
+
+    return TRUE;
+}
+
+static int compara_par(const void *a, const void *b)
+{
+    const int32_t *x = a, *y = b;
+
+    return (x[0] > y[0]) - (x[0] < y[0]);
+}
+
+/* Bytes ocupados pela tabela de nomes */
+static size_t bytes_nomes(grafo_csr_t *csr)
+{
+    size_t tamanho = 0;
+    int i;
+
+    for (i = 0; i < csr->n; i++)
+        if (csr->nome_offsets[i] >= 0)
+            tamanho = csr->nome_offsets[i] + strlen(csr->nomes + csr->nome_offsets[i]) + 1;
+
+    return tamanho;
+}
+
+/**
+  * @brief  Grava a fotografia em arquivo binário
+  * @param	csr: fotografia de origem
+  * @param  arquivo: caminho do arquivo (ex.: tempo.csv.csr)
+  *
+  * Além dos vetores da fotografia, grava os pares (id, índice) ordenados por
+  * id, que substituem a tabela hash quando o arquivo é mapeado.
+  *
+  * @retval Nenhum
+  */
+void salva_grafo_csr(grafo_csr_t *csr, const char *arquivo)
+{
+    cabecalho_csr_t c;
+    secoes_csr_t s;
+    int32_t *por_id;
+    size_t posicao = 0;
+    FILE *fp;
+    int i, ok;
+
+    if (csr == NULL || arquivo == NULL)
+    {
+        fprintf(stderr, "salva_grafo_csr: parametros invalidos\n");
+        exit(EXIT_FAILURE);
+    }
+
+    if (!little_endian())
+    {
+        fprintf(stderr, "salva_grafo_csr: maquina nao e little-endian\n");
+        exit(EXIT_FAILURE);
+    }
+
+    memset(&c, 0, sizeof(c));
+    memcpy(c.magico, CSR_MAGICO, sizeof(CSR_MAGICO));
+    c.versao = CSR_VERSAO;
+    c.ordem = CSR_ORDEM;
+    c.n = csr->n;
+    c.m = csr->m;
+    c.pesos_inteiros = csr->pesos_inteiros != NULL;
+    c.peso_maximo = csr->peso_maximo;
+    c.tamanho_nomes = bytes_nomes(csr);
+    calcula_secoes(&c, &s);
+
+    if (csr->por_id)
+        por_id = (int32_t *)csr->por_id;
+    else
+    {
+        por_id = aloca(2 * (size_t)csr->n * sizeof(int32_t));
+        for (i = 0; i < csr->n; i++)
+        {
+            por_id[2 * i] = csr->ids[i];
+            por_id[2 * i + 1] = i;
+        }
+        qsort(por_id, csr->n, 2 * sizeof(int32_t), compara_par);
+    }
+
+    fp = fopen(arquivo, "wb");
+    if (fp == NULL)
+    {
+        perror("salva_grafo_csr:");
+        exit(EXIT_FAILURE);
+    }
+
+    ok = escreve_secao(fp, &posicao, 0, &c, sizeof(c)) &&
+         escreve_secao(fp, &posicao, s.ids, csr->ids, c.n * sizeof(int32_t)) &&
+         escreve_secao(fp, &posicao, s.offsets, csr->offsets, (c.n + 1) * sizeof(int32_t)) &&
+         escreve_secao(fp, &posicao, s.vizinhos, csr->vizinhos, c.m * sizeof(int32_t)) &&
+         escreve_secao(fp, &posicao, s.pesos, csr->pesos, c.m * sizeof(float)) &&
+         (!c.pesos_inteiros ||
+          escreve_secao(fp, &posicao, s.pesos_inteiros, csr->pesos_inteiros,
+                        c.m * sizeof(int32_t))) &&
+         escreve_secao(fp, &posicao, s.nome_offsets, csr->nome_offsets, c.n * sizeof(int32_t)) &&
+         escreve_secao(fp, &posicao, s.por_id, por_id, 2 * (size_t)c.n * sizeof(int32_t)) &&
+         escreve_secao(fp, &posicao, s.nomes, csr->nomes, c.tamanho_nomes);
+
+    if (!csr->por_id)
+        free(por_id);
+
+    if (!ok || fclose(fp) != 0)
+    {
+        perror("salva_grafo_csr:");
+        exit(EXIT_FAILURE);
+    }
+}
+
+static void arquivo_invalido(const char *arquivo)
+{
+    fprintf(stderr, "carrega_grafo_csr: arquivo invalido: %s\n", arquivo);
+    exit(EXIT_FAILURE);
+}
+
+/**
+  * @brief  Abre uma fotografia gravada por salva_grafo_csr
+  * @param	arquivo: caminho do arquivo
+  *
+  * O arquivo é mapeado somente leitura e os vetores apontam diretamente para
+  * as páginas mapeadas: nada é lido ou convertido, e processos que abrem o
+  * mesmo arquivo compartilham as páginas do cache do sistema. São
+  * verificados o cabeçalho, o tamanho, os vetores por vértice e os destinos
+  * das arestas, para que nenhum índice do arquivo aponte fora do mapa.
+  *
+  * @retval grafo_csr_t: fotografia somente leitura
+  */
+grafo_csr_t *carrega_grafo_csr(const char *arquivo)
+{
+    cabecalho_csr_t c;
+    secoes_csr_t s;
+    struct stat info;
+    grafo_csr_t *csr;
+    char *base;
+    int fd, i;
+
+    if (arquivo == NULL)
+    {
+        fprintf(stderr, "carrega_grafo_csr: parametros invalidos\n");
+        exit(EXIT_FAILURE);
+    }
+
+    if (!little_endian() || sizeof(int) != sizeof(int32_t))
+    {
+        fprintf(stderr, "carrega_grafo_csr: formato nao suportado nesta maquina\n");
+        exit(EXIT_FAILURE);
+    }
+
+    fd = open(arquivo, O_RDONLY);
+    if (fd < 0)
+    {
+        perror("carrega_grafo_csr:");
+        exit(EXIT_FAILURE);
+    }
+
+    if (fstat(fd, &info) != 0 || (size_t)info.st_size < sizeof(c))
+        arquivo_invalido(arquivo);
+
+    csr = aloca(sizeof(grafo_csr_t));
+    csr->tamanho_mapa = info.st_size;
+    csr->mapa = mmap(NULL, csr->tamanho_mapa, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+
+    if (csr->mapa == MAP_FAILED)
+    {
+        perror("carrega_grafo_csr:");
+        exit(EXIT_FAILURE);
+    }
+
+    memcpy(&c, csr->mapa, sizeof(c));
+    if (memcmp(c.magico, CSR_MAGICO, sizeof(CSR_MAGICO)) != 0 || c.ordem != CSR_ORDEM)
+        arquivo_invalido(arquivo);
+
+    if (c.versao != CSR_VERSAO)
+    {
+        fprintf(stderr, "carrega_grafo_csr: versao %u nao suportada: %s\n",
+                (unsigned)c.versao, arquivo);
+        exit(EXIT_FAILURE);
+    }
+
+    if (c.n < 0 || c.m < 0)
+        arquivo_invalido(arquivo);
+
+    calcula_secoes(&c, &s);
+    if (csr->tamanho_mapa < s.fim)
+        arquivo_invalido(arquivo);
+
+    base = csr->mapa;
+    csr->n = c.n;
+    csr->m = c.m;
+    csr->ids = (int *)(base + s.ids);
+    csr->offsets = (int *)(base + s.offsets);
+    csr->vizinhos = (int *)(base + s.vizinhos);
+    csr->pesos = (float *)(base + s.pesos);
+    csr->pesos_inteiros = c.pesos_inteiros ? (int *)(base + s.pesos_inteiros) : NULL;
+    csr->peso_maximo = c.pesos_inteiros ? c.peso_maximo : 0;
+    csr->nome_offsets = (int *)(base + s.nome_offsets);
+    csr->por_id = (const int32_t *)(base + s.por_id);
+    csr->nomes = base + s.nomes;
+    csr->indices = NULL;
+
+    if (csr->offsets[0] != 0 || csr->offsets[csr->n] != csr->m ||
+        (c.tamanho_nomes > 0 && csr->nomes[c.tamanho_nomes - 1] != '\0'))
+        arquivo_invalido(arquivo);
+
+    for (i = 0; i < csr->n; i++)
+        if (csr->offsets[i] > csr->offsets[i + 1] ||
+            csr->nome_offsets[i] < -1 ||
+            csr->nome_offsets[i] >= (int64_t)c.tamanho_nomes ||
+            csr->por_id[2 * i + 1] < 0 || csr->por_id[2 * i + 1] >= csr->n ||
+            (i > 0 && csr->por_id[2 * i] <= csr->por_id[2 * i - 2]))
+            arquivo_invalido(arquivo);
+
+    for (i = 0; i < csr->m; i++)
+        if (csr->vizinhos[i] < 0 || csr->vizinhos[i] >= csr->n)
+            arquivo_invalido(arquivo);
+
+    return csr;
+}
+
+int csr_num_vertices(grafo_csr_t *csr)
+{
+    return csr->n;
+}
+
+int csr_num_arestas(grafo_csr_t *csr)
+{
+    return csr->m;
+}
+
+const int *csr_offsets(grafo_csr_t *csr)
+{
+    return csr->offsets;
+}
+
+const int *csr_vizinhos(grafo_csr_t *csr)
+{
+    return csr->vizinhos;
+}
+
+const float *csr_pesos(grafo_csr_t *csr)
+{
+    return csr->pesos;
+}
+
+const int *csr_pesos_inteiros(grafo_csr_t *csr)
+{
+    return csr->pesos_inteiros;
+}
+
+int csr_peso_maximo(grafo_csr_t *csr)
+{
+    return csr->peso_maximo;
+}
+
+int csr_id(grafo_csr_t *csr, int v)
+{
+    if (csr == NULL || v < 0 || v >= csr->n)
+    {
+        fprintf(stderr, "csr_id: vertice invalido\n");
+        exit(EXIT_FAILURE);
+    }
+
+    return csr->ids[v];
+}
+
+const char *csr_nome(grafo_csr_t *csr, int v)
+{
+    if (csr == NULL || v < 0 || v >= csr->n)
+    {
+        fprintf(stderr, "csr_nome: vertice invalido\n");
+        exit(EXIT_FAILURE);
+    }
+
+    return csr->nome_offsets[v] >= 0 ? csr->nomes + csr->nome_offsets[v] : NULL;
+}
+
+int csr_indice(grafo_csr_t *csr, int id)
+{
+    int inicio = 0, fim, meio;
+
+    if (csr->indices)
+        return tabela_hash_buscar(csr->indices, id);
+
+    /* Fotografia mapeada: busca binaria nos pares ordenados */
+    fim = csr->n;
+    while (inicio < fim)
+    {
+        meio = inicio + (fim - inicio) / 2;
+        if (csr->por_id[2 * meio] < id)
+            inicio = meio + 1;
+        else
+            fim = meio;
+    }
+
+    return inicio < csr->n && csr->por_id[2 * inicio] == id ? csr->por_id[2 * inicio + 1] : -1;
+}
@@ -0,0 +1,237 @@
+/*
+ * grafo_matriz.c
+ *
+ * Matriz de adjacencia densa em um unico vetor (ordem por linhas).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "grafo_matriz.h"
+#include "tabela_hash.h"
+
+struct grafos_matriz
+{
+    int n;                  /*!< Numero de vertices */
+    int capacidade;         /*!< Vertices comportados: pesos tem capacidade^2 posicoes */
+    float *pesos;           /*!< pesos[u * capacidade + v]. INFINITY: sem aresta */
+    int *ids;               /*!< Identificacao de cada vertice */
+    char **nomes;           /*!< Nome de cada vertice */
+    tabela_hash_t *indices; /*!< id -> indice denso */
+};
+
+static void *aloca(size_t tamanho)
+{
+    void *p = malloc(tamanho > 0 ? tamanho : 1);
+
+    if (p == NULL)
+    {
+        perror("grafo_matriz:");
+        exit(EXIT_FAILURE);
+    }
+
+    return p;
+}
+
+static void verifica_vertice(grafo_matriz_t *matriz, int v)
+{
+    if (matriz == NULL || v < 0 || v >= matriz->n)
+    {
+        fprintf(stderr, "grafo_matriz: vertice invalido\n");
+        exit(EXIT_FAILURE);
+    }
+}
+
+/* Aloca pesos, ids e nomes para capacidade vertices, preservando os atuais */
+static void redimensiona(grafo_matriz_t *matriz, int capacidade)
+{
+    float *pesos;
+    int u, v;
+
+    pesos = aloca((size_t) capacidade * capacidade * sizeof(float));
+    for (u = 0; u < capacidade; u++)
+        for (v = 0; v < capacidade; v++)
+            pesos[(size_t) u * capacidade + v] = (u < matriz->n && v < matriz->n) ?
+                matriz->pesos[(size_t) u * matriz->capacidade + v] : INFINITY;
+
+    free(matriz->pesos);
+    matriz->pesos = pesos;
+
+    matriz->ids = realloc(matriz->ids, capacidade * sizeof(int));
+    matriz->nomes = realloc(matriz->nomes, capacidade * sizeof(char*));
+    if (matriz->ids == NULL || matriz->nomes == NULL)
+    {
+        perror("grafo_matriz:");
+        exit(EXIT_FAILURE);
+    }
+
+    matriz->capacidade = capacidade;
+}
+
+/**
+  * @brief  Cria um grafo em matriz de adjacência
+  * @param	capacidade: número de vértices esperado
+  *
+  * @retval grafo_matriz_t: ponteiro para o novo grafo, sem vértices
+  */
+grafo_matriz_t *cria_grafo_matriz(int capacidade)
+{
+    grafo_matriz_t *p = aloca(sizeof(grafo_matriz_t));
+
+    p->n = 0;
+    p->capacidade = 0;
+    p->pesos = NULL;
+    p->ids = NULL;
+    p->nomes = NULL;
+    p->indices = cria_tabela_hash(capacidade);
+
+    redimensiona(p, capacidade > 0 ? capacidade : 1);
+
+    return p;
+}
+
+/**
+  * @brief  Adiciona um vértice sem arestas
+  * @param	matriz: grafo
+  * @param  id: identificação do vértice (única)
+  * @param  nome: nome do vértice, copiado. Pode ser NULL
+  *
+  * @retval int: índice denso do vértice
+  */
+int matriz_adicionar_vertice(grafo_matriz_t *matriz, int id, const char *nome)
+{
+    int v;
+
+    if (matriz == NULL)
+    {
+        fprintf(stderr, "matriz_adicionar_vertice: grafo invalido\n");
+        exit(EXIT_FAILURE);
+    }
+
+    if (tabela_hash_buscar(matriz->indices, id) != HASH_AUSENTE)
+    {
+        fprintf(stderr, "matriz_adicionar_vertice: vertice duplicado!\n");
+        exit(EXIT_FAILURE);
+    }
+
+    if (matriz->n == matriz->capacidade)
+        redimensiona(matriz, 2 * matriz->capacidade);
+
+    v = matriz->n++;
+    matriz->ids[v] = id;
+    matriz->nomes[v] = NULL;
+    matriz_set_nome(matriz, v, nome);
+    tabela_hash_inserir(matriz->indices, id, v);
+
+    return v;
+}
+
+/**
+  * @brief  Reserva espaço para capacidade vértices sem realocar depois
+  * @param	matriz: grafo
+  * @param  capacidade: número total de vértices esperado
+  *
+  * @retval Nenhum
+  */
+void matriz_reserva(grafo_matriz_t *matriz, int capacidade)
+{
+    if (matriz == NULL)
+    {
+        fprintf(stderr, "matriz_reserva: grafo invalido\n");
+        exit(EXIT_FAILURE);
+    }
+
+    if (capacidade > matriz->capacidade)
+        redimensiona(matriz, capacidade);
+}
+
+void matriz_set_nome(grafo_matriz_t *matriz, int v, const char *nome)
+{
+    verifica_vertice(matriz, v);
+
+    free(matriz->nomes[v]);
+    matriz->nomes[v] = NULL;
+    if (nome)
+    {
+        matriz->nomes[v] = aloca(strlen(nome) + 1);
+        strcpy(matriz->nomes[v], nome);
+    }
+}
+
+int matriz_indice(grafo_matriz_t *matriz, int id)
+{
+    return tabela_hash_buscar(matriz->indices, id);
+}
+
+int matriz_num_vertices(grafo_matriz_t *matriz)
+{
+    return matriz->n;
+}
+
+int matriz_id(grafo_matriz_t *matriz, int v)
+{
+    verifica_vertice(matriz, v);
+
+    return matriz->ids[v];
+}
+
+const char *matriz_nome(grafo_matriz_t *matriz, int v)
+{
+    verifica_vertice(matriz, v);
+
+    return matriz->nomes[v];
+}
+
+void matriz_adiciona_aresta(grafo_matriz_t *matriz, int u, int v, float peso)
+{
+    float *uv, *vu;
+
+    verifica_vertice(matriz, u);
+    verifica_vertice(matriz, v);
+
+    if (u == v)
+        return;
+
+    uv = &matriz->pesos[(size_t) u * matriz->capacidade + v];
+    vu = &matriz->pesos[(size_t) v * matriz->capacidade + u];
+
+    if (peso < *uv)
+        *uv = *vu = peso;
+}
+
+float matriz_get_peso(grafo_matriz_t *matriz, int u, int v)
+{
+    verifica_vertice(matriz, u);
+    verifica_vertice(matriz, v);
+
+    return matriz->pesos[(size_t) u * matriz->capacidade + v];
+}
+
+const float *matriz_linha(grafo_matriz_t *matriz, int u)
+{
+    verifica_vertice(matriz, u);
+
+    return &matriz->pesos[(size_t) u * matriz->capacidade];
+}
+
+void libera_grafo_matriz(grafo_matriz_t *matriz)
+{
+    int v;
+
+    if (matriz == NULL)
+    {
+        fprintf(stderr, "libera_grafo_matriz: grafo invalido\n");
+        exit(EXIT_FAILURE);
+    }
+
+    for (v = 0; v < matriz->n; v++)
+        free(matriz->nomes[v]);
+
+    libera_tabela_hash(matriz->indices);
+    free(matriz->nomes);
+    free(matriz->ids);
+    free(matriz->pesos);
+    free(matriz);
+}
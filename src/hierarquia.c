@@ -0,0 +1,1001 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "hierarquia.h"
+#include "paralelo.h"
+
+#define FALSE 0
+#define TRUE 1
+
+#define CH_MAGICO "GTCH001"
+
+/* Vertices assentados por busca de testemunha. Uma busca interrompida
+ * apenas cria um atalho a mais, nunca um caminho errado */
+#define CH_LIMITE_TESTEMUNHA 500
+
+/* Cabecalho do arquivo, seguido de ids e niveis (n int32 cada) e das
+ * arestas de subida e de descida, cada grupo em offsets (n + 1), alvos,
+ * meios (int32) e pesos (float) */
+typedef struct cabecalho_hierarquia
+{
+    char magico[8];
+    int32_t n;
+    int32_t m_subida;
+    int32_t m_descida;
+    int32_t reservado;
+} cabecalho_hierarquia_t;
+
+/* Arestas de cada vertice para vertices de nivel maior, em CSR. Na subida,
+ * alvo e o destino da aresta v -> alvo; na descida, alvo e a origem da
+ * aresta alvo -> v, percorrida ao contrario pela busca a partir do destino.
+ * meio e o vertice contraido que o atalho substitui, -1 se original */
+struct hierarquia
+{
+    int n;
+    int32_t *ids;
+    int32_t *nivel;
+
+    int32_t *sub_offsets;
+    int32_t *sub_alvos;
+    int32_t *sub_meios;
+    float *sub_pesos;
+
+    int32_t *desc_offsets;
+    int32_t *desc_alvos;
+    int32_t *desc_meios;
+    float *desc_pesos;
+
+    void *mapa;                 /*!< Regiao de mmap, NULL se em malloc */
+    size_t tamanho_mapa;
+};
+
+/* Grafo dinamico usado durante a contracao */
+typedef struct arco
+{
+    int alvo;
+    float peso;
+    int meio;
+} arco_t;
+
+typedef struct lista_arcos
+{
+    arco_t *arcos;
+    int tamanho;
+    int capacidade;
+} lista_arcos_t;
+
+typedef struct atalho
+{
+    int u, w, meio;
+    float peso;
+} atalho_t;
+
+/* Estado de uma thread: espaco das buscas de testemunha e atalhos
+ * encontrados na rodada */
+typedef struct trabalho
+{
+    espaco_busca_t *espaco;
+    char *alvo;                 /*!< Marca os vizinhos de saida de v */
+    atalho_t *atalhos;
+    int num_atalhos;
+    int capacidade;
+} trabalho_t;
+
+typedef struct contracao
+{
+    int n;
+    lista_arcos_t *saida;       /*!< Arestas para vertices nao contraidos */
+    lista_arcos_t *entrada;     /*!< Arestas vindas de vertices nao contraidos */
+    int *nivel;                 /*!< Ordem de contracao, -1 se nao contraido */
+    char *na_rodada;            /*!< Sera contraido nesta rodada */
+    int *prioridade;
+    int *vizinhos_contraidos;
+
+    int *lista;                 /*!< Vertices da fase paralela atual */
+    int tamanho_lista;
+    int proximo;                /*!< Proxima posicao de lista a processar */
+    trabalho_t *trabalhos;
+} contracao_t;
+
+static void *aloca(size_t tamanho)
+{
+    void *p = malloc(tamanho > 0 ? tamanho : 1);
+
+    if (p == NULL)
+    {
+        perror("hierarquia:");
+        exit(EXIT_FAILURE);
+    }
+
+    return p;
+}
+
+static void *realoca(void *p, size_t tamanho)
+{
+    p = realloc(p, tamanho > 0 ? tamanho : 1);
+
+    if (p == NULL)
+    {
+        perror("hierarquia:");
+        exit(EXIT_FAILURE);
+    }
+
+    return p;
+}
+
+/* Insere a aresta ou, se ja houver uma para alvo, mantem a mais leve */
+static void lista_adiciona(lista_arcos_t *lista, int alvo, float peso, int meio)
+{
+    int i;
+
+    for (i = 0; i < lista->tamanho; i++)
+        if (lista->arcos[i].alvo == alvo)
+        {
+            if (peso < lista->arcos[i].peso)
+            {
+                lista->arcos[i].peso = peso;
+                lista->arcos[i].meio = meio;
+            }
+            return;
+        }
+
+    if (lista->tamanho == lista->capacidade)
+    {
+        lista->capacidade = lista->capacidade ? 2 * lista->capacidade : 4;
+        lista->arcos = realoca(lista->arcos, lista->capacidade * sizeof(arco_t));
+    }
+
+    lista->arcos[lista->tamanho].alvo = alvo;
+    lista->arcos[lista->tamanho].peso = peso;
+    lista->arcos[lista->tamanho].meio = meio;
+    lista->tamanho++;
+}
+
+static void lista_remove(lista_arcos_t *lista, int alvo)
+{
+    int i;
+
+    for (i = 0; i < lista->tamanho; i++)
+        if (lista->arcos[i].alvo == alvo)
+        {
+            lista->arcos[i] = lista->arcos[--lista->tamanho];
+            return;
+        }
+}
+
+/* Dijkstra limitado a partir de u sem passar por v nem pelos vertices da
+ * rodada; para quando os alvos marcados forem assentados. As distancias
+ * ficam no espaco */
+static void busca_testemunhas(contracao_t *c, trabalho_t *t, int u, int v,
+                              int alvos, float limite)
+{
+    espaco_busca_t *espaco = t->espaco;
+    fila_prioridade_t *fila;
+    lista_arcos_t *lista;
+    int x, w, i, assentados = 0;
+    float d, nova;
+
+    espaco_reinicia(espaco);
+    fila = espaco_fila_prioridade(espaco);
+
+    espaco_set_dist(espaco, u, 0);
+    fila_prioridade_inserir(fila, u, 0);
+
+    while (!fila_prioridade_vazia(fila))
+    {
+        x = fila_prioridade_remover_min(fila, &d);
+        if (d > limite || ++assentados > CH_LIMITE_TESTEMUNHA)
+            break;
+        if (t->alvo[x] && x != u && --alvos == 0)
+            break;
+
+        lista = &c->saida[x];
+        for (i = 0; i < lista->tamanho; i++)
+        {
+            w = lista->arcos[i].alvo;
+            if (w == v || c->na_rodada[w])
+                continue;
+
+            nova = d + lista->arcos[i].peso;
+            if (nova < espaco_get_dist(espaco, w))
+            {
+                espaco_set_dist(espaco, w, nova);
+                fila_prioridade_atualizar(fila, w, nova);
+            }
+        }
+    }
+}
+
+/* Atalhos necessarios para contrair v. Com grava, sao acrescentados aos
+ * atalhos da thread. Retorna quantos seriam criados */
+static int simula_contracao(contracao_t *c, trabalho_t *t, int v, int grava)
+{
+    lista_arcos_t *entrada = &c->entrada[v], *saida = &c->saida[v];
+    int i, j, u, w, alvos, atalhos = 0;
+    float puv, maior, via;
+
+    for (j = 0; j < saida->tamanho; j++)
+        t->alvo[saida->arcos[j].alvo] = TRUE;
+
+    for (i = 0; i < entrada->tamanho; i++)
+    {
+        u = entrada->arcos[i].alvo;
+        puv = entrada->arcos[i].peso;
+
+        maior = -1;
+        for (j = 0; j < saida->tamanho; j++)
+            if (saida->arcos[j].alvo != u && saida->arcos[j].peso > maior)
+                maior = saida->arcos[j].peso;
+        if (maior < 0)
+            continue;
+
+        /* u tambem pode ser vizinho de saida, mas nao e alvo de si mesmo */
+        alvos = saida->tamanho - t->alvo[u];
+        busca_testemunhas(c, t, u, v, alvos, puv + maior);
+
+        for (j = 0; j < saida->tamanho; j++)
+        {
+            w = saida->arcos[j].alvo;
+            via = puv + saida->arcos[j].peso;
+            if (w == u || espaco_get_dist(t->espaco, w) <= via)
+                continue;
+
+            atalhos++;
+            if (!grava)
+                continue;
+
+            if (t->num_atalhos == t->capacidade)
+            {
+                t->capacidade = t->capacidade ? 2 * t->capacidade : 64;
+                t->atalhos = realoca(t->atalhos, t->capacidade * sizeof(atalho_t));
+            }
+            t->atalhos[t->num_atalhos].u = u;
+            t->atalhos[t->num_atalhos].w = w;
+            t->atalhos[t->num_atalhos].meio = v;
+            t->atalhos[t->num_atalhos].peso = via;
+            t->num_atalhos++;
+        }
+    }
+
+    for (j = 0; j < saida->tamanho; j++)
+        t->alvo[saida->arcos[j].alvo] = FALSE;
+
+    return atalhos;
+}
+
+/* Diferenca de arestas mais vizinhos ja contraidos, que espalha a
+ * contracao pelo grafo */
+static void tarefa_prioridades(void *contexto, int i)
+{
+    contracao_t *c = contexto;
+    trabalho_t *t = &c->trabalhos[i];
+    int k, v;
+
+    for (;;)
+    {
+        k = __atomic_fetch_add(&c->proximo, 1, __ATOMIC_RELAXED);
+        if (k >= c->tamanho_lista)
+            break;
+
+        v = c->lista[k];
+        c->prioridade[v] = simula_contracao(c, t, v, FALSE) -
+                           c->entrada[v].tamanho - c->saida[v].tamanho +
+                           c->vizinhos_contraidos[v];
+    }
+}
+
+static void tarefa_atalhos(void *contexto, int i)
+{
+    contracao_t *c = contexto;
+    trabalho_t *t = &c->trabalhos[i];
+    int k;
+
+    for (;;)
+    {
+        k = __atomic_fetch_add(&c->proximo, 1, __ATOMIC_RELAXED);
+        if (k >= c->tamanho_lista)
+            break;
+
+        simula_contracao(c, t, c->lista[k], TRUE);
+    }
+}
+
+static void executa(contracao_t *c, int num_threads, void (*tarefa)(void *, int))
+{
+    c->proximo = 0;
+    paralelo_executa(num_threads, num_threads, tarefa, c);
+}
+
+/* Desempate pseudoaleatorio entre prioridades iguais, para que vertices
+ * vizinhos de mesma prioridade nao formem longas cadeias de espera */
+static unsigned int mistura(int v)
+{
+    return (unsigned int)v * 2654435761u;
+}
+
+static int menos_importante(contracao_t *c, int v, int x)
+{
+    if (c->prioridade[v] != c->prioridade[x])
+        return c->prioridade[v] < c->prioridade[x];
+    if (mistura(v) != mistura(x))
+        return mistura(v) < mistura(x);
+    return v < x;
+}
+
+/* v e menos importante que todos os vizinhos nao contraidos */
+static int minimo_local(contracao_t *c, int v)
+{
+    int i;
+
+    for (i = 0; i < c->saida[v].tamanho; i++)
+        if (!menos_importante(c, v, c->saida[v].arcos[i].alvo))
+            return FALSE;
+
+    for (i = 0; i < c->entrada[v].tamanho; i++)
+        if (!menos_importante(c, v, c->entrada[v].arcos[i].alvo))
+            return FALSE;
+
+    return TRUE;
+}
+
+/* Copia as listas congeladas na contracao para vetores CSR */
+static void monta_csr(lista_arcos_t *listas, int n, int32_t **offsets, int32_t **alvos,
+                      int32_t **meios, float **pesos)
+{
+    int v, i, k, m = 0;
+
+    for (v = 0; v < n; v++)
+        m += listas[v].tamanho;
+
+    *offsets = aloca((n + 1) * sizeof(int32_t));
+    *alvos = aloca(m * sizeof(int32_t));
+    *meios = aloca(m * sizeof(int32_t));
+    *pesos = aloca(m * sizeof(float));
+
+    k = 0;
+    for (v = 0; v < n; v++)
+    {
+        (*offsets)[v] = k;
+        for (i = 0; i < listas[v].tamanho; i++, k++)
+        {
+            (*alvos)[k] = listas[v].arcos[i].alvo;
+            (*meios)[k] = listas[v].arcos[i].meio;
+            (*pesos)[k] = listas[v].arcos[i].peso;
+        }
+    }
+    (*offsets)[n] = k;
+}
+
+/**
+  * @brief  Contrai o grafo e monta a hierarquia
+  * @param	csr: grafo com pesos não negativos, dirigido ou não
+  * @param  num_threads: número de threads (0: uma por núcleo)
+  *
+  * Cada rodada: (1) seleciona os mínimos locais de prioridade, um conjunto
+  * independente; (2) em paralelo, as buscas de testemunha encontram os
+  * atalhos de cada selecionado, sem atravessar os demais selecionados;
+  * (3) os atalhos são inseridos e os selecionados saem do grafo; (4) em
+  * paralelo, recalcula a prioridade dos vizinhos afetados. As listas de
+  * um vértice no momento da contração só contêm vértices de nível maior e
+  * são a sua parte da hierarquia.
+  *
+  * @retval hierarquia_t: hierarquia em memória
+  */
+hierarquia_t *cria_hierarquia(grafo_csr_t *csr, int num_threads)
+{
+    hierarquia_t *h;
+    contracao_t c;
+    const int *offsets, *vizinhos;
+    const float *pesos;
+    atalho_t *a;
+    int *restantes, num_restantes, contraidos = 0;
+    char *afetado;
+    int n, i, j, k, v, x;
+
+    if (csr == NULL || num_threads < 0)
+    {
+        fprintf(stderr, "cria_hierarquia: parametros invalidos\n");
+        exit(EXIT_FAILURE);
+    }
+
+    if (num_threads == 0)
+        num_threads = paralelo_num_threads();
+
+    n = csr_num_vertices(csr);
+    c.n = n;
+    c.saida = calloc(n > 0 ? n : 1, sizeof(lista_arcos_t));
+    c.entrada = calloc(n > 0 ? n : 1, sizeof(lista_arcos_t));
+    c.nivel = aloca(n * sizeof(int));
+    c.na_rodada = calloc(n > 0 ? n : 1, 1);
+    c.prioridade = aloca(n * sizeof(int));
+    c.vizinhos_contraidos = calloc(n > 0 ? n : 1, sizeof(int));
+    c.lista = aloca(n * sizeof(int));
+    c.trabalhos = aloca(num_threads * sizeof(trabalho_t));
+    restantes = aloca(n * sizeof(int));
+    afetado = calloc(n > 0 ? n : 1, 1);
+    if (c.saida == NULL || c.entrada == NULL || c.na_rodada == NULL ||
+        c.vizinhos_contraidos == NULL || afetado == NULL)
+    {
+        perror("cria_hierarquia:");
+        exit(EXIT_FAILURE);
+    }
+
+    for (i = 0; i < num_threads; i++)
+    {
+        c.trabalhos[i].espaco = cria_espaco_busca(n, HEAP_DARIO);
+        c.trabalhos[i].alvo = calloc(n > 0 ? n : 1, 1);
+        if (c.trabalhos[i].alvo == NULL)
+        {
+            perror("cria_hierarquia:");
+            exit(EXIT_FAILURE);
+        }
+        c.trabalhos[i].atalhos = NULL;
+        c.trabalhos[i].num_atalhos = 0;
+        c.trabalhos[i].capacidade = 0;
+    }
+
+    /* Grafo dinamico, sem lacos e com uma aresta por par. As listas de
+     * entrada ja fazem o papel do transposto */
+    offsets = csr_offsets(csr);
+    vizinhos = csr_vizinhos(csr);
+    pesos = csr_pesos(csr);
+    for (v = 0; v < n; v++)
+        for (k = offsets[v]; k < offsets[v + 1]; k++)
+            if (vizinhos[k] != v)
+            {
+                lista_adiciona(&c.saida[v], vizinhos[k], pesos[k], -1);
+                lista_adiciona(&c.entrada[vizinhos[k]], v, pesos[k], -1);
+            }
+
+    for (v = 0; v < n; v++)
+    {
+        c.nivel[v] = -1;
+        restantes[v] = v;
+        c.lista[v] = v;
+    }
+    num_restantes = n;
+
+    c.tamanho_lista = n;
+    executa(&c, num_threads, tarefa_prioridades);
+
+    while (num_restantes > 0)
+    {
+        /* (1) Conjunto independente */
+        c.tamanho_lista = 0;
+        for (i = 0; i < num_restantes; i++)
+            if (minimo_local(&c, restantes[i]))
+                c.lista[c.tamanho_lista++] = restantes[i];
+
+        for (i = 0; i < c.tamanho_lista; i++)
+            c.na_rodada[c.lista[i]] = TRUE;
+
+        /* (2) Atalhos */
+        executa(&c, num_threads, tarefa_atalhos);
+
+        /* (3) Contracao */
+        for (j = 0; j < num_threads; j++)
+        {
+            for (i = 0; i < c.trabalhos[j].num_atalhos; i++)
+            {
+                a = &c.trabalhos[j].atalhos[i];
+                lista_adiciona(&c.saida[a->u], a->w, a->peso, a->meio);
+                lista_adiciona(&c.entrada[a->w], a->u, a->peso, a->meio);
+            }
+            c.trabalhos[j].num_atalhos = 0;
+        }
+
+        for (i = 0; i < c.tamanho_lista; i++)
+        {
+            v = c.lista[i];
+            c.nivel[v] = contraidos++;
+            c.na_rodada[v] = FALSE;
+
+            for (k = 0; k < c.saida[v].tamanho; k++)
+            {
+                x = c.saida[v].arcos[k].alvo;
+                lista_remove(&c.entrada[x], v);
+                c.vizinhos_contraidos[x]++;
+                afetado[x] = TRUE;
+            }
+            for (k = 0; k < c.entrada[v].tamanho; k++)
+            {
+                x = c.entrada[v].arcos[k].alvo;
+                lista_remove(&c.saida[x], v);
+                c.vizinhos_contraidos[x]++;
+                afetado[x] = TRUE;
+            }
+        }
+
+        /* (4) Prioridades dos vizinhos */
+        j = 0;
+        c.tamanho_lista = 0;
+        for (i = 0; i < num_restantes; i++)
+        {
+            v = restantes[i];
+            if (c.nivel[v] >= 0)
+                continue;
+
+            restantes[j++] = v;
+            if (afetado[v])
+            {
+                c.lista[c.tamanho_lista++] = v;
+                afetado[v] = FALSE;
+            }
+        }
+        num_restantes = j;
+
+        executa(&c, num_threads, tarefa_prioridades);
+    }
+
+    h = aloca(sizeof(hierarquia_t));
+    h->n = n;
+    h->ids = aloca(n * sizeof(int32_t));
+    h->nivel = aloca(n * sizeof(int32_t));
+    h->mapa = NULL;
+    h->tamanho_mapa = 0;
+
+    for (v = 0; v < n; v++)
+    {
+        h->ids[v] = csr_id(csr, v);
+        h->nivel[v] = c.nivel[v];
+    }
+
+    monta_csr(c.saida, n, &h->sub_offsets, &h->sub_alvos, &h->sub_meios, &h->sub_pesos);
+    monta_csr(c.entrada, n, &h->desc_offsets, &h->desc_alvos, &h->desc_meios, &h->desc_pesos);
+
+    for (v = 0; v < n; v++)
+    {
+        free(c.saida[v].arcos);
+        free(c.entrada[v].arcos);
+    }
+    for (i = 0; i < num_threads; i++)
+    {
+        libera_espaco_busca(c.trabalhos[i].espaco);
+        free(c.trabalhos[i].alvo);
+        free(c.trabalhos[i].atalhos);
+    }
+    free(c.saida);
+    free(c.entrada);
+    free(c.nivel);
+    free(c.na_rodada);
+    free(c.prioridade);
+    free(c.vizinhos_contraidos);
+    free(c.lista);
+    free(c.trabalhos);
+    free(restantes);
+    free(afetado);
+
+    return h;
+}
+
+/**
+  * @brief  Grava a hierarquia em arquivo binário
+  * @param	hierarquia: hierarquia calculada ou carregada
+  * @param  arquivo: caminho do arquivo (ex.: tempo.csv.ch)
+  *
+  * O arquivo usa a ordem de bytes da máquina.
+  *
+  * @retval Nenhum
+  */
+void salva_hierarquia(hierarquia_t *hierarquia, const char *arquivo)
+{
+    hierarquia_t *h = hierarquia;
+    cabecalho_hierarquia_t c;
+    size_t n, ms, md;
+    FILE *fp;
+
+    if (h == NULL || arquivo == NULL)
+    {
+        fprintf(stderr, "salva_hierarquia: parametros invalidos\n");
+        exit(EXIT_FAILURE);
+    }
+
+    fp = fopen(arquivo, "wb");
+    if (fp == NULL)
+    {
+        perror("salva_hierarquia:");
+        exit(EXIT_FAILURE);
+    }
+
+    memset(&c, 0, sizeof(c));
+    memcpy(c.magico, CH_MAGICO, sizeof(c.magico));
+    c.n = h->n;
+    c.m_subida = h->sub_offsets[h->n];
+    c.m_descida = h->desc_offsets[h->n];
+
+    n = c.n;
+    ms = c.m_subida;
+    md = c.m_descida;
+
+    if (fwrite(&c, sizeof(c), 1, fp) != 1 ||
+        fwrite(h->ids, sizeof(int32_t), n, fp) != n ||
+        fwrite(h->nivel, sizeof(int32_t), n, fp) != n ||
+        fwrite(h->sub_offsets, sizeof(int32_t), n + 1, fp) != n + 1 ||
+        fwrite(h->sub_alvos, sizeof(int32_t), ms, fp) != ms ||
+        fwrite(h->sub_meios, sizeof(int32_t), ms, fp) != ms ||
+        fwrite(h->sub_pesos, sizeof(float), ms, fp) != ms ||
+        fwrite(h->desc_offsets, sizeof(int32_t), n + 1, fp) != n + 1 ||
+        fwrite(h->desc_alvos, sizeof(int32_t), md, fp) != md ||
+        fwrite(h->desc_meios, sizeof(int32_t), md, fp) != md ||
+        fwrite(h->desc_pesos, sizeof(float), md, fp) != md ||
+        fclose(fp) != 0)
+    {
+        perror("salva_hierarquia:");
+        exit(EXIT_FAILURE);
+    }
+}
+
+/* Offsets crescentes terminando em m, alvos e meios dentro do grafo */
+static int arestas_validas(int n, const int32_t *offsets, const int32_t *alvos,
+                           const int32_t *meios, int m)
+{
+    int v, k;
+
+    if (offsets[0] != 0 || offsets[n] != m)
+        return FALSE;
+
+    for (v = 0; v < n; v++)
+        if (offsets[v + 1] < offsets[v])
+            return FALSE;
+
+    for (k = 0; k < m; k++)
+        if (alvos[k] < 0 || alvos[k] >= n || meios[k] < -1 || meios[k] >= n)
+            return FALSE;
+
+    return TRUE;
+}
+
+/**
+  * @brief  Abre uma hierarquia gravada por salva_hierarquia
+  * @param	arquivo: caminho do arquivo
+  * @param  csr: grafo das consultas
+  *
+  * @retval hierarquia_t: hierarquia somente leitura, mapeada na memória
+  */
+hierarquia_t *carrega_hierarquia(const char *arquivo, grafo_csr_t *csr)
+{
+    cabecalho_hierarquia_t c;
+    struct stat info;
+    hierarquia_t *h;
+    size_t n, ms, md;
+    int32_t *p;
+    int fd, v;
+
+    if (arquivo == NULL || csr == NULL)
+    {
+        fprintf(stderr, "carrega_hierarquia: parametros invalidos\n");
+        exit(EXIT_FAILURE);
+    }
+
+    fd = open(arquivo, O_RDONLY);
+    if (fd < 0)
+    {
+        perror("carrega_hierarquia:");
+        exit(EXIT_FAILURE);
+    }
+
+    if (fstat(fd, &info) != 0 || (size_t)info.st_size < sizeof(c))
+    {
+        fprintf(stderr, "carrega_hierarquia: arquivo invalido: %s\n", arquivo);
+        exit(EXIT_FAILURE);
+    }
+
+    h = aloca(sizeof(hierarquia_t));
+    h->tamanho_mapa = info.st_size;
+    h->mapa = mmap(NULL, h->tamanho_mapa, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+
+    if (h->mapa == MAP_FAILED)
+    {
+        perror("carrega_hierarquia:");
+        exit(EXIT_FAILURE);
+    }
+
+    memcpy(&c, h->mapa, sizeof(c));
+    n = c.n;
+    ms = c.m_subida;
+    md = c.m_descida;
+    if (memcmp(c.magico, CH_MAGICO, sizeof(c.magico)) != 0 || c.n < 0 ||
+        c.m_subida < 0 || c.m_descida < 0 ||
+        h->tamanho_mapa < sizeof(c) + (4 * n + 2 + 3 * ms + 3 * md) * sizeof(int32_t))
+    {
+        fprintf(stderr, "carrega_hierarquia: arquivo invalido: %s\n", arquivo);
+        exit(EXIT_FAILURE);
+    }
+
+    p = (int32_t *)((char *)h->mapa + sizeof(c));
+    h->n = c.n;
+    h->ids = p;             p += n;
+    h->nivel = p;           p += n;
+    h->sub_offsets = p;     p += n + 1;
+    h->sub_alvos = p;       p += ms;
+    h->sub_meios = p;       p += ms;
+    h->sub_pesos = (float *)p;  p += ms;
+    h->desc_offsets = p;    p += n + 1;
+    h->desc_alvos = p;      p += md;
+    h->desc_meios = p;      p += md;
+    h->desc_pesos = (float *)p;
+
+    if (h->n != csr_num_vertices(csr))
+    {
+        fprintf(stderr, "carrega_hierarquia: %s nao corresponde ao grafo\n", arquivo);
+        exit(EXIT_FAILURE);
+    }
+
+    for (v = 0; v < h->n; v++)
+        if (h->ids[v] != csr_id(csr, v))
+        {
+            fprintf(stderr, "carrega_hierarquia: %s nao corresponde ao grafo\n", arquivo);
+            exit(EXIT_FAILURE);
+        }
+
+    for (v = 0; v < h->n; v++)
+        if (h->nivel[v] < 0 || h->nivel[v] >= h->n)
+            break;
+
+    if (v < h->n ||
+        !arestas_validas(h->n, h->sub_offsets, h->sub_alvos, h->sub_meios, c.m_subida) ||
+        !arestas_validas(h->n, h->desc_offsets, h->desc_alvos, h->desc_meios, c.m_descida))
+    {
+        fprintf(stderr, "carrega_hierarquia: arquivo invalido: %s\n", arquivo);
+        exit(EXIT_FAILURE);
+    }
+
+    return h;
+}
+
+int hierarquia_num_vertices(hierarquia_t *hierarquia)
+{
+    return hierarquia->n;
+}
+
+int hierarquia_num_arestas(hierarquia_t *hierarquia)
+{
+    return hierarquia->sub_offsets[hierarquia->n] + hierarquia->desc_offsets[hierarquia->n];
+}
+
+int hierarquia_nivel(hierarquia_t *hierarquia, int v)
+{
+    if (hierarquia == NULL || v < 0 || v >= hierarquia->n)
+    {
+        fprintf(stderr, "hierarquia_nivel: vertice invalido\n");
+        exit(EXIT_FAILURE);
+    }
+
+    return hierarquia->nivel[v];
+}
+
+/* Assenta o menor vertice de um dos sentidos e relaxa suas arestas
+ * ascendentes, atualizando o melhor caminho pelos rotulos do outro */
+static void sobe(const int32_t *offsets, const int32_t *alvos, const float *pesos,
+                 espaco_busca_t *este, espaco_busca_t *outro, float *melhor, int *encontro)
+{
+    fila_prioridade_t *fila = espaco_fila_prioridade(este);
+    int k, u, w;
+    float d, nova, total;
+
+    u = fila_prioridade_remover_min(fila, &d);
+    espaco_visita(este, u);
+
+    for (k = offsets[u]; k < offsets[u + 1]; k++)
+    {
+        w = alvos[k];
+        nova = d + pesos[k];
+        if (nova < espaco_get_dist(este, w))
+        {
+            espaco_set_dist(este, w, nova);
+            espaco_set_pai(este, w, u);
+            fila_prioridade_atualizar(fila, w, nova);
+        }
+
+        total = espaco_get_dist(este, w) + espaco_get_dist(outro, w);
+        if (total < *melhor)
+        {
+            *melhor = total;
+            *encontro = w;
+        }
+    }
+}
+
+/**
+  * @brief  Busca bidirecional ascendente
+  * @param	hierarquia: hierarquia do grafo
+  * @param  fonte: índice de origem
+  * @param  destino: índice de destino
+  * @param  frente: espaço da busca a partir da fonte
+  * @param  tras: espaço da busca a partir do destino
+  * @param  encontro: recebe o vértice de encontro
+  *
+  * Como as buscas só sobem, elas não se encontram necessariamente no
+  * primeiro vértice comum: cada sentido continua enquanto o seu menor
+  * rótulo for menor que o melhor caminho conhecido.
+  *
+  * @retval float: distância de fonte a destino (INFINITY se inalcançável)
+  */
+float hierarquia_consulta(hierarquia_t *hierarquia, int fonte, int destino,
+                          espaco_busca_t *frente, espaco_busca_t *tras, int *encontro)
+{
+    hierarquia_t *h = hierarquia;
+    fila_prioridade_t *fila_frente, *fila_tras;
+    float melhor = INFINITY, min_frente, min_tras;
+    int ativa_frente, ativa_tras, meio = -1;
+
+    if (h == NULL || frente == NULL || tras == NULL || frente == tras || encontro == NULL ||
+        espaco_num_vertices(frente) < h->n || espaco_num_vertices(tras) < h->n)
+    {
+        fprintf(stderr, "hierarquia_consulta: parametros invalidos\n");
+        exit(EXIT_FAILURE);
+    }
+
+    if (fonte < 0 || destino < 0 || fonte >= h->n || destino >= h->n)
+    {
+        fprintf(stderr, "hierarquia_consulta: vertice invalido\n");
+        exit(EXIT_FAILURE);
+    }
+
+    espaco_reinicia(frente);
+    espaco_reinicia(tras);
+    fila_frente = espaco_fila_prioridade(frente);
+    fila_tras = espaco_fila_prioridade(tras);
+
+    espaco_set_dist(frente, fonte, 0);
+    fila_prioridade_inserir(fila_frente, fonte, 0);
+    espaco_set_dist(tras, destino, 0);
+    fila_prioridade_inserir(fila_tras, destino, 0);
+
+    if (fonte == destino)
+    {
+        melhor = 0;
+        meio = fonte;
+    }
+
+    for (;;)
+    {
+        ativa_frente = !fila_prioridade_vazia(fila_frente);
+        if (ativa_frente)
+        {
+            fila_prioridade_minimo(fila_frente, &min_frente);
+            ativa_frente = min_frente < melhor;
+        }
+
+        ativa_tras = !fila_prioridade_vazia(fila_tras);
+        if (ativa_tras)
+        {
+            fila_prioridade_minimo(fila_tras, &min_tras);
+            ativa_tras = min_tras < melhor;
+        }
+
+        if (ativa_frente && (!ativa_tras || min_frente <= min_tras))
+            sobe(h->sub_offsets, h->sub_alvos, h->sub_pesos, frente, tras, &melhor, &meio);
+        else if (ativa_tras)
+            sobe(h->desc_offsets, h->desc_alvos, h->desc_pesos, tras, frente, &melhor, &meio);
+        else
+            break;
+    }
+
+    *encontro = meio;
+
+    return melhor;
+}
+
+/* Vertice contraido que a aresta a -> b substitui, -1 se original. A
+ * aresta esta na subida de a ou na descida de b, conforme o mais baixo */
+static int meio_aresta(hierarquia_t *h, int a, int b)
+{
+    int k;
+
+    if (h->nivel[a] < h->nivel[b])
+    {
+        for (k = h->sub_offsets[a]; k < h->sub_offsets[a + 1]; k++)
+            if (h->sub_alvos[k] == b)
+                return h->sub_meios[k];
+    }
+    else
+    {
+        for (k = h->desc_offsets[b]; k < h->desc_offsets[b + 1]; k++)
+            if (h->desc_alvos[k] == a)
+                return h->desc_meios[k];
+    }
+
+    fprintf(stderr, "hierarquia_caminho: aresta %d -> %d inexistente\n", a, b);
+    exit(EXIT_FAILURE);
+}
+
+/* Acrescenta ao caminho os vertices depois de a ate b. O meio de um atalho
+ * tem nivel menor que os extremos, o que limita a recursao */
+static int desempacota(hierarquia_t *h, int a, int b, int *caminho, int tamanho)
+{
+    int meio = meio_aresta(h, a, b);
+
+    if (meio < 0)
+    {
+        if (caminho)
+            caminho[tamanho] = b;
+        return tamanho + 1;
+    }
+
+    tamanho = desempacota(h, a, meio, caminho, tamanho);
+    return desempacota(h, meio, b, caminho, tamanho);
+}
+
+int hierarquia_caminho(hierarquia_t *hierarquia, espaco_busca_t *frente,
+                       espaco_busca_t *tras, int encontro, int *caminho, int max)
+{
+    hierarquia_t *h = hierarquia;
+    int *subida, num_subida = 0, metade, tamanho, i, v;
+
+    if (h == NULL || frente == NULL || tras == NULL || encontro >= h->n)
+    {
+        fprintf(stderr, "hierarquia_caminho: parametros invalidos\n");
+        exit(EXIT_FAILURE);
+    }
+
+    if (encontro < 0)
+        return 0;
+
+    /* Caminho na hierarquia: fonte .. encontro pela frente, depois
+     * encontro .. destino pelos pais de tras */
+    for (v = encontro; v >= 0; v = espaco_get_pai(frente, v))
+        num_subida++;
+    metade = num_subida;
+    for (v = espaco_get_pai(tras, encontro); v >= 0; v = espaco_get_pai(tras, v))
+        num_subida++;
+
+    subida = aloca(num_subida * sizeof(int));
+    i = metade - 1;
+    for (v = encontro; v >= 0; v = espaco_get_pai(frente, v))
+        subida[i--] = v;
+    i = metade;
+    for (v = espaco_get_pai(tras, encontro); v >= 0; v = espaco_get_pai(tras, v))
+        subida[i++] = v;
+
+    tamanho = 1;
+    for (i = 0; i + 1 < num_subida; i++)
+        tamanho = desempacota(h, subida[i], subida[i + 1], NULL, tamanho);
+
+    if (tamanho <= max && caminho != NULL)
+    {
+        caminho[0] = subida[0];
+        tamanho = 1;
+        for (i = 0; i + 1 < num_subida; i++)
+            tamanho = desempacota(h, subida[i], subida[i + 1], caminho, tamanho);
+    }
+
+    free(subida);
+
+    return tamanho;
+}
+
+void libera_hierarquia(hierarquia_t *hierarquia)
+{
+    if (hierarquia == NULL)
+    {
+        fprintf(stderr, "libera_hierarquia: hierarquia invalida\n");
+        exit(EXIT_FAILURE);
+    }
+
+    if (hierarquia->mapa)
+        munmap(hierarquia->mapa, hierarquia->tamanho_mapa);
+    else
+    {
+        free(hierarquia->ids);
+        free(hierarquia->nivel);
+        free(hierarquia->sub_offsets);
+        free(hierarquia->sub_alvos);
+        free(hierarquia->sub_meios);
+        free(hierarquia->sub_pesos);
+        free(hierarquia->desc_offsets);
+        free(hierarquia->desc_alvos);
+        free(hierarquia->desc_meios);
+        free(hierarquia->desc_pesos);
+    }
+
+    free(hierarquia);
+}
@@ -0,0 +1,387 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "leitor_tabela.h"
+
+#define FALSE 0
+#define TRUE 1
+
+#define TAMANHO_BLOCO (1 << 20)
+
+/* Conteudo do arquivo em memoria */
+typedef struct conteudo
+{
+    char *dados;
+    size_t tamanho;
+    int mapeado;        /*!< TRUE: dados vem de mmap; FALSE: de malloc */
+} conteudo_t;
+
+static void erro_tabela(const char *arquivo, int linha, const char *mensagem)
+{
+    fprintf(stderr, "le_tabela: %s, linha %d: %s\n", arquivo, linha, mensagem);
+    exit(EXIT_FAILURE);
+}
+
+/* Mapeia o arquivo; se nao for possivel (ex.: pipe), le em blocos grandes */
+static void carrega(const char *arquivo, conteudo_t *c)
+{
+    struct stat info;
+    size_t capacidade, lidos;
+    FILE *fp;
+    int fd;
+
+    fd = open(arquivo, O_RDONLY);
+    if (fd < 0)
+    {
+        perror("Erro ao ler tabela");
+        exit(EXIT_FAILURE);
+    }
+
+    if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0)
+    {
+        c->dados = mmap(NULL, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (c->dados != MAP_FAILED)
+        {
+            madvise(c->dados, info.st_size, MADV_SEQUENTIAL);
+            c->tamanho = info.st_size;
+            c->mapeado = TRUE;
+            close(fd);
+            return;
+        }
+    }
+
+    fp = fdopen(fd, "r");
+    if (fp == NULL)
+    {
+        perror("Erro ao ler tabela");
+        exit(EXIT_FAILURE);
+    }
+
+    c->mapeado = FALSE;
+    c->tamanho = 0;
+    capacidade = TAMANHO_BLOCO;
+    c->dados = malloc(capacidade);
+
+    while (c->dados)
+    {
+        lidos = fread(c->dados + c->tamanho, 1, capacidade - c->tamanho, fp);
+        c->tamanho += lidos;
+        if (c->tamanho < capacidade)
+            break;
+        capacidade *= 2;
+        c->dados = realloc(c->dados, capacidade);
+    }
+
+    if (c->dados == NULL || ferror(fp))
+    {
+        perror("Erro ao ler tabela");
+        exit(EXIT_FAILURE);
+    }
+
+    fclose(fp);
+}
+
+static void descarrega(conteudo_t *c)
+{
+    if (c->mapeado)
+        munmap(c->dados, c->tamanho);
+    else
+        free(c->dados);
+}
+
+/* Fim da linha que comeca em p, sem '\n' e '\r' */
+static const char *fim_linha(const char *p, const char *fim, const char **proxima)
+{
+    const char *nl = memchr(p, '\n', fim - p);
+
+    if (nl == NULL)
+    {
+        *proxima = fim;
+        nl = fim;
+    }
+    else
+        *proxima = nl + 1;
+
+    if (nl > p && nl[-1] == '\r')
+        nl--;
+
+    return nl;
+}
+
+/* Fim do campo que comeca em p: proxima virgula ou fim da linha */
+static const char *fim_campo(const char *p, const char *fim)
+{
+    while (p < fim && *p != ',')
+        p++;
+
+    return p;
+}
+
+/* Remove espacos nas extremidades do campo [*p, *fim) */
+static void apara(const char **p, const char **fim)
+{
+    while (*p < *fim && (**p == ' ' || **p == '\t'))
+        (*p)++;
+    while (*fim > *p && ((*fim)[-1] == ' ' || (*fim)[-1] == '\t'))
+        (*fim)--;
+}
+
+/* Converte inteiro decimal em [p, fim). Retorna FALSE se invalido */
+static int converte_inteiro(const char *p, const char *fim, int *valor)
+{
+    int sinal = 1, v = 0;
+
+    if (p < fim && *p == '-')
+    {
+        sinal = -1;
+        p++;
+    }
+
+    if (p == fim)
+        return FALSE;
+
+    for (; p < fim; p++)
+    {
+        if (*p < '0' || *p > '9')
+            return FALSE;
+        v = v * 10 + (*p - '0');
+    }
+
+    *valor = sinal * v;
+
+    return TRUE;
+}
+
+/**
+  * @brief  Converte um tempo no formato "HH.MM" sem sscanf
+  * @param  texto: início do campo (não precisa terminar em '\0')
+  * @param  n: tamanho do campo
+  *
+  * @retval float: valor numérico (6.21 para "06.21"). -1 se vazio, negativo
+  *                ou inválido
+  */
+float converte_tempo(const char *texto, int n)
+{
+    const char *p = texto, *fim = texto + n;
+    double mantissa = 0, escala = 1;
+
+    if (n <= 0 || *p == '-')
+        return -1;
+
+    for (; p < fim && *p >= '0' && *p <= '9'; p++)
+        mantissa = mantissa * 10 + (*p - '0');
+
+    if (p < fim && *p == '.')
+        for (p++; p < fim && *p >= '0' && *p <= '9'; p++)
+        {
+            mantissa = mantissa * 10 + (*p - '0');
+            escala *= 10;
+        }
+
+    if (p != fim || p == texto)
+        return -1;
+
+    return (float) (mantissa / escala);
+}
+
+/**
+  * @brief  Converte um tempo no formato "HH.MM" em minutos inteiros
+  * @param  texto: início do campo (não precisa terminar em '\0')
+  * @param  n: tamanho do campo
+  *
+  * Um único dígito após o ponto é lido como dezenas ("6.3" são 6h30).
+  *
+  * @retval int: HH * 60 + MM (381 para "06.21"). -1 se vazio, negativo,
+  *              inválido ou com mais de 59 minutos
+  */
+int converte_minutos(const char *texto, int n)
+{
+    const char *p = texto, *fim = texto + n;
+    long horas = 0;
+    int minutos = 0, digitos = 0;
+
+    if (n <= 0 || *p == '-')
+        return -1;
+
+    for (; p < fim && *p >= '0' && *p <= '9'; p++)
+    {
+        horas = horas * 10 + (*p - '0');
+        if (horas > (INT_MAX - 59) / 60)
+            return -1;
+    }
+
+    if (p < fim && *p == '.')
+        for (p++; p < fim && *p >= '0' && *p <= '9' && digitos < 2; p++, digitos++)
+            minutos = minutos * 10 + (*p - '0');
+
+    if (p != fim || p == texto)
+        return -1;
+
+    if (digitos == 1)
+        minutos *= 10;
+
+    if (minutos > 59)
+        return -1;
+
+    return (int) horas * 60 + minutos;
+}
+
+/**
+  * @brief  Lê a tabela de tempos em uma única passada
+  * @param  arquivo: caminho do arquivo CSV
+  * @param  leitor: funções que recebem colunas, cidades e tempos
+  *
+  * @retval Nenhum
+  */
+void le_tabela(const char *arquivo, leitor_tabela_t *leitor)
+{
+    conteudo_t c;
+    const char *p, *fim, *linha_fim, *proxima, *campo_fim, *inicio;
+    int *colunas = NULL, n_colunas = 0, capacidade = 0;
+    int linha = 1, j, id, estimativa;
+    char *nome;
+    int tamanho_nome = 64;
+    float tempo;
+
+    carrega(arquivo, &c);
+    p = c.dados;
+    fim = c.dados + c.tamanho;
+
+    /* Linha 1: rotulo, campo vazio e identificacao das cidades das colunas */
+    linha_fim = fim_linha(p, fim, &proxima);
+    p = fim_campo(p, linha_fim);
+    p = (p < linha_fim) ? fim_campo(p + 1, linha_fim) : p;
+
+    while (p < linha_fim)
+    {
+        campo_fim = fim_campo(++p, linha_fim);
+        inicio = p;
+        p = campo_fim;
+        apara(&inicio, &campo_fim);
+
+        /* Apenas o ultimo campo pode estar vazio (separador no fim da
+         * linha); qualquer outro deslocaria as colunas seguintes */
+        if (campo_fim == inicio)
+        {
+            if (p < linha_fim)
+                erro_tabela(arquivo, linha, "identificacao de coluna vazia");
+            continue;
+        }
+
+        if (n_colunas == capacidade)
+        {
+            capacidade = capacidade ? 2 * capacidade : 32;
+            colunas = realloc(colunas, capacidade * sizeof(int));
+            if (colunas == NULL)
+            {
+                perror("Erro ao alocar colunas");
+                exit(EXIT_FAILURE);
+            }
+        }
+
+        if (!converte_inteiro(inicio, campo_fim, &colunas[n_colunas]))
+            erro_tabela(arquivo, linha, "identificacao de coluna invalida");
+
+        n_colunas++;
+    }
+
+    if (n_colunas == 0)
+        erro_tabela(arquivo, linha, "nenhuma coluna encontrada");
+
+    /* Linha 2: nomes das colunas, ignorada */
+    p = proxima;
+    linha++;
+    fim_linha(p, fim, &proxima);
+    p = proxima;
+
+    /* Estimativa do numero de cidades pelo tamanho da primeira linha de dados */
+    fim_linha(p, fim, &proxima);
+    estimativa = (proxima > p) ? (int) ((fim - p) / (proxima - p)) + 1 : 0;
+
+    leitor->inicio(leitor->destino, estimativa, n_colunas);
+    for (j = 0; j < n_colunas; j++)
+        leitor->coluna(leitor->destino, j, colunas[j]);
+
+    nome = malloc(tamanho_nome);
+    if (nome == NULL)
+    {
+        perror("Erro ao alocar nome da cidade");
+        exit(EXIT_FAILURE);
+    }
+
+    while (p < fim)
+    {
+        linha++;
+        linha_fim = fim_linha(p, fim, &proxima);
+
+        if (linha_fim == p)
+        {
+            p = proxima;
+            continue;
+        }
+
+        campo_fim = fim_campo(p, linha_fim);
+        inicio = p;
+        p = campo_fim;
+        apara(&inicio, &campo_fim);
+        if (!converte_inteiro(inicio, campo_fim, &id) || p == linha_fim)
+            erro_tabela(arquivo, linha, "identificacao da cidade invalida");
+
+        campo_fim = fim_campo(++p, linha_fim);
+        inicio = p;
+        p = campo_fim;
+        apara(&inicio, &campo_fim);
+        if (campo_fim - inicio + 1 > tamanho_nome)
+        {
+            tamanho_nome = campo_fim - inicio + 1;
+            nome = realloc(nome, tamanho_nome);
+            if (nome == NULL)
+            {
+                perror("Erro ao alocar nome da cidade");
+                exit(EXIT_FAILURE);
+            }
+        }
+        memcpy(nome, inicio, campo_fim - inicio);
+        nome[campo_fim - inicio] = '\0';
+
+        #ifdef DEBUG
+        printf("%d - %s\n", id, nome);
+        #endif
+
+        leitor->vertice(leitor->destino, id, nome);
+
+        for (j = 0; p < linha_fim; j++)
+        {
+            campo_fim = fim_campo(++p, linha_fim);
+            inicio = p;
+            p = campo_fim;
+            apara(&inicio, &campo_fim);
+            if (campo_fim == inicio)
+                continue;
+
+            if (j >= n_colunas)
+                erro_tabela(arquivo, linha, "mais tempos que colunas");
+
+            if (leitor->unidade == TEMPO_MINUTOS)
+                tempo = (float) converte_minutos(inicio, campo_fim - inicio);
+            else
+                tempo = converte_tempo(inicio, campo_fim - inicio);
+            if (tempo >= 0)
+                leitor->celula(leitor->destino, id, j, tempo);
+            else if (!(campo_fim - inicio == 2 && inicio[0] == '-' && inicio[1] == '1'))
+                erro_tabela(arquivo, linha, "tempo invalido");
+        }
+
+        p = proxima;
+    }
+
+    free(nome);
+    free(colunas);
+    descarrega(&c);
+}
@@ -36,6 +36,22 @@ lista_enc_t *cria_lista_enc (void) {
     return p;
 }
 
+/**
+  * @brief  Cria uma nova lista encadeada vazia dentro de uma arena.
+  * @param	arena: arena que contém a lista
+  *
+  * @retval lista_enc_t *: ponteiro (referência) da nova lista encadeada.
+  */
+lista_enc_t *cria_lista_enc_arena(arena_t *arena) {
+    lista_enc_t *p = arena_aloca(arena, sizeof(lista_enc_t));
+
+    p->cabeca = NULL;
+    p->cauda = NULL;
+    p->tamanho = 0;
+
+    return p;
+}
+
 /**
   * @brief  Adiciona um nó de lista no final.
   * @param	lista: lista encadeada que se deseja adicionar.
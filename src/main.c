@@ -4,11 +4,45 @@
 #include "grafo.h"
 #include "algoritimos.h"
 
+#ifdef DEBUG
+#include "floyd_warshall.h"
+
+/* Regressao: pesos nao inteiros (k / 7) com arestas de peso zero e mais
+ * vertices que um bloco. Os proximos nao podem formar lacos */
+static void confere_floyd(void)
+{
+    grafo_matriz_t *m = cria_grafo_matriz(122);
+    unsigned long semente = 12345;
+    int u, v, k;
+
+    for (u = 0; u < 122; u++)
+        matriz_adicionar_vertice(m, u, "");
+
+    for (u = 0; u < 122; u++)
+        for (v = u + 1; v < 122; v++)
+        {
+            semente = (semente * 1103515245 + 12345) % 2147483648UL;
+            k = semente >> 16;
+            if (k % 3 == 0)
+                matriz_adiciona_aresta(m, u, v, (k % 5 == 0 ? 0 : k % 40) / 7.0f);
+        }
+
+    if (!floyd_warshall_confere(m, 0))
+        exit(EXIT_FAILURE);
+
+    libera_grafo_matriz(m);
+}
+#endif
+
 int main()
 {
     grafo_t *g, *spanning_tree;
     char table[] = "tempo.csv";
 
+#ifdef DEBUG
+    confere_floyd();
+#endif
+
     g = cria_grafo(100);
     read_table(g, table);
     spanning_tree = prim_algorithm(g, 4205407);
@@ -0,0 +1,339 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#include "motor.h"
+#include "algoritmos_csr.h"
+
+#define FALSE 0
+#define TRUE 1
+
+#define FILA_INICIAL 64
+
+typedef struct trabalhador
+{
+    motor_t *motor;
+    pthread_t thread;
+    espaco_busca_t *espaco;     /*!< Estado das consultas desta thread */
+} trabalhador_t;
+
+struct motores
+{
+    grafo_csr_t *csr;
+
+    trabalhador_t *trabalhadores;
+    int num_trabalhadores;
+
+    /* Fila circular de consultas, protegida por trava */
+    consulta_t **fila;
+    int capacidade;
+    int cabeca;
+    int tamanho;
+    int pendentes;              /*!< Submetidas e ainda nao respondidas */
+    int encerrar;
+
+    pthread_mutex_t trava;
+    pthread_cond_t ha_trabalho;
+    pthread_cond_t concluido;
+};
+
+static void *aloca(size_t tamanho)
+{
+    void *p = malloc(tamanho > 0 ? tamanho : 1);
+
+    if (p == NULL)
+    {
+        perror("motor:");
+        exit(EXIT_FAILURE);
+    }
+
+    return p;
+}
+
+static void responde_dijkstra(grafo_csr_t *csr, espaco_busca_t *espaco, consulta_t *c)
+{
+    c->custo = dijkstra_csr_espaco(csr, c->fonte, c->destino, espaco);
+    c->alcancados = 0;
+    c->tamanho_caminho = 0;
+
+    if (c->destino >= 0)
+        c->tamanho_caminho = caminho_csr_espaco(espaco, c->destino,
+                                                c->caminho, c->max_caminho);
+}
+
+static void responde_bfs(grafo_csr_t *csr, espaco_busca_t *espaco, consulta_t *c)
+{
+    c->alcancados = bfs_csr_espaco(csr, c->fonte, espaco);
+    c->custo = 0;
+    c->tamanho_caminho = 0;
+
+    if (c->destino >= 0)
+    {
+        c->custo = espaco_get_dist(espaco, c->destino);
+        c->tamanho_caminho = caminho_csr_espaco(espaco, c->destino,
+                                                c->caminho, c->max_caminho);
+    }
+}
+
+static void responde_prim(grafo_csr_t *csr, espaco_busca_t *espaco, consulta_t *c)
+{
+    int i, n = csr_num_vertices(csr);
+
+    c->custo = prim_csr_espaco(csr, c->fonte, espaco);
+    c->tamanho_caminho = 0;
+
+    c->alcancados = 0;
+    for (i = 0; i < n; i++)
+        c->alcancados += espaco_visitado(espaco, i);
+}
+
+/* Executa a consulta com o espaco da thread */
+static void responde(grafo_csr_t *csr, espaco_busca_t *espaco, consulta_t *c)
+{
+    int i, n = csr_num_vertices(csr);
+
+    switch (c->tipo)
+    {
+    case CONSULTA_DIJKSTRA:
+        responde_dijkstra(csr, espaco, c);
+        break;
+    case CONSULTA_BFS:
+        responde_bfs(csr, espaco, c);
+        break;
+    case CONSULTA_PRIM:
+        responde_prim(csr, espaco, c);
+        break;
+    default:
+        fprintf(stderr, "motor: tipo de consulta invalido\n");
+        exit(EXIT_FAILURE);
+    }
+
+    if (c->pai)
+        for (i = 0; i < n; i++)
+            c->pai[i] = espaco_get_pai(espaco, i);
+}
+
+static void *trabalha(void *arg)
+{
+    trabalhador_t *t = arg;
+    motor_t *motor = t->motor;
+    consulta_t *c;
+
+    for (;;)
+    {
+        pthread_mutex_lock(&motor->trava);
+        while (motor->tamanho == 0 && !motor->encerrar)
+            pthread_cond_wait(&motor->ha_trabalho, &motor->trava);
+
+        if (motor->tamanho == 0)
+        {
+            pthread_mutex_unlock(&motor->trava);
+            return NULL;
+        }
+
+        c = motor->fila[motor->cabeca];
+        motor->cabeca = (motor->cabeca + 1) % motor->capacidade;
+        motor->tamanho--;
+        pthread_mutex_unlock(&motor->trava);
+
+        /* O grafo e somente leitura: apenas a fila precisa da trava */
+        responde(motor->csr, t->espaco, c);
+
+        pthread_mutex_lock(&motor->trava);
+        if (--motor->pendentes == 0)
+            pthread_cond_broadcast(&motor->concluido);
+        pthread_mutex_unlock(&motor->trava);
+    }
+}
+
+/**
+  * @brief  Cria o motor de consultas
+  * @param	grafo: grafo a ser congelado
+  * @param  num_trabalhadores: número de threads. 0 usa uma por núcleo
+  *
+  * @retval motor_t: motor pronto para receber consultas
+  */
+motor_t *cria_motor(grafo_t *grafo, int num_trabalhadores)
+{
+    if (grafo == NULL || num_trabalhadores < 0)
+    {
+        fprintf(stderr, "cria_motor: parametros invalidos\n");
+        exit(EXIT_FAILURE);
+    }
+
+    return cria_motor_csr(cria_grafo_csr(grafo), num_trabalhadores);
+}
+
+/**
+  * @brief  Cria o motor sobre uma fotografia pronta
+  * @param	csr: fotografia, por exemplo de carrega_grafo_csr. Passa a
+  *              pertencer ao motor
+  * @param  num_trabalhadores: número de threads. 0 usa uma por núcleo
+  *
+  * @retval motor_t: motor pronto para receber consultas
+  */
+motor_t *cria_motor_csr(grafo_csr_t *csr, int num_trabalhadores)
+{
+    motor_t *motor;
+    long nucleos;
+    int i, n;
+
+    if (csr == NULL || num_trabalhadores < 0)
+    {
+        fprintf(stderr, "cria_motor_csr: parametros invalidos\n");
+        exit(EXIT_FAILURE);
+    }
+
+    if (num_trabalhadores == 0)
+    {
+        nucleos = sysconf(_SC_NPROCESSORS_ONLN);
+        num_trabalhadores = nucleos > 0 ? (int)nucleos : 1;
+    }
+
+    motor = aloca(sizeof(motor_t));
+    motor->csr = csr;
+    motor->num_trabalhadores = num_trabalhadores;
+    motor->capacidade = FILA_INICIAL;
+    motor->fila = aloca(motor->capacidade * sizeof(consulta_t*));
+    motor->cabeca = 0;
+    motor->tamanho = 0;
+    motor->pendentes = 0;
+    motor->encerrar = FALSE;
+
+    pthread_mutex_init(&motor->trava, NULL);
+    pthread_cond_init(&motor->ha_trabalho, NULL);
+    pthread_cond_init(&motor->concluido, NULL);
+
+    n = csr_num_vertices(motor->csr);
+    motor->trabalhadores = aloca(num_trabalhadores * sizeof(trabalhador_t));
+
+    for (i = 0; i < num_trabalhadores; i++)
+    {
+        motor->trabalhadores[i].motor = motor;
+        motor->trabalhadores[i].espaco = cria_espaco_busca(n, HEAP_DARIO);
+
+        if (pthread_create(&motor->trabalhadores[i].thread, NULL, trabalha,
+                           &motor->trabalhadores[i]) != 0)
+        {
+            fprintf(stderr, "cria_motor: falha ao criar thread\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    return motor;
+}
+
+/* Dobra a fila circular, desenrolando-a a partir da cabeca */
+static void aumenta_fila(motor_t *motor)
+{
+    consulta_t **nova;
+    int i;
+
+    nova = aloca(2 * motor->capacidade * sizeof(consulta_t*));
+    for (i = 0; i < motor->tamanho; i++)
+        nova[i] = motor->fila[(motor->cabeca + i) % motor->capacidade];
+
+    free(motor->fila);
+    motor->fila = nova;
+    motor->cabeca = 0;
+    motor->capacidade *= 2;
+}
+
+/**
+  * @brief  Enfileira uma consulta
+  * @param	motor: motor de consultas
+  * @param  consulta: consulta do chamador; recebe o resultado
+  *
+  * @retval Nenhum
+  */
+void motor_submeter(motor_t *motor, consulta_t *consulta)
+{
+    int n;
+
+    if (motor == NULL || consulta == NULL)
+    {
+        fprintf(stderr, "motor_submeter: parametros invalidos\n");
+        exit(EXIT_FAILURE);
+    }
+
+    /* Valida aqui para que o erro aponte para quem submeteu */
+    n = csr_num_vertices(motor->csr);
+    if (consulta->fonte < 0 || consulta->fonte >= n ||
+        consulta->destino < -1 || consulta->destino >= n ||
+        (consulta->caminho != NULL && consulta->max_caminho < 0))
+    {
+        fprintf(stderr, "motor_submeter: consulta invalida\n");
+        exit(EXIT_FAILURE);
+    }
+
+    pthread_mutex_lock(&motor->trava);
+
+    if (motor->tamanho == motor->capacidade)
+        aumenta_fila(motor);
+
+    motor->fila[(motor->cabeca + motor->tamanho) % motor->capacidade] = consulta;
+    motor->tamanho++;
+    motor->pendentes++;
+
+    pthread_cond_signal(&motor->ha_trabalho);
+    pthread_mutex_unlock(&motor->trava);
+}
+
+void motor_aguardar(motor_t *motor)
+{
+    if (motor == NULL)
+    {
+        fprintf(stderr, "motor_aguardar: motor invalido\n");
+        exit(EXIT_FAILURE);
+    }
+
+    pthread_mutex_lock(&motor->trava);
+    while (motor->pendentes > 0)
+        pthread_cond_wait(&motor->concluido, &motor->trava);
+    pthread_mutex_unlock(&motor->trava);
+}
+
+int motor_num_trabalhadores(motor_t *motor)
+{
+    return motor->num_trabalhadores;
+}
+
+grafo_csr_t *motor_csr(motor_t *motor)
+{
+    return motor->csr;
+}
+
+void libera_motor(motor_t *motor)
+{
+    int i;
+
+    if (motor == NULL)
+    {
+        fprintf(stderr, "libera_motor: motor invalido\n");
+        exit(EXIT_FAILURE);
+    }
+
+    motor_aguardar(motor);
+
+    pthread_mutex_lock(&motor->trava);
+    motor->encerrar = TRUE;
+    pthread_cond_broadcast(&motor->ha_trabalho);
+    pthread_mutex_unlock(&motor->trava);
+
+    for (i = 0; i < motor->num_trabalhadores; i++)
+    {
+        pthread_join(motor->trabalhadores[i].thread, NULL);
+        libera_espaco_busca(motor->trabalhadores[i].espaco);
+    }
+
+    pthread_mutex_destroy(&motor->trava);
+    pthread_cond_destroy(&motor->ha_trabalho);
+    pthread_cond_destroy(&motor->concluido);
+
+    libera_grafo_csr(motor->csr);
+    free(motor->trabalhadores);
+    free(motor->fila);
+    free(motor);
+}
@@ -31,6 +31,29 @@ no_t *cria_no(void *dado)
     return p;
 }
 
+/**
+  * @brief  Cria um novo nó de lista encadeada a partir de um pool.
+  * @param	pool: pool com objetos de tamanho_no() bytes
+  * @param	dado: ponteiro genérico para qualquer tipo de dado.
+  *
+  * @retval no_t: ponteiro do tipo nó contendo a referência do dado.
+  */
+no_t *cria_no_pool(pool_t *pool, void *dado)
+{
+    no_t *p = pool_aloca(pool);
+
+    p->dados = dado;
+    p->proximo = NULL;
+    p->anterior = NULL;
+
+    return p;
+}
+
+size_t tamanho_no(void)
+{
+    return sizeof(no_t);
+}
+
 /**
   * @brief  Faz o encadeamento entre dois nós de encadeados.
   * @param	fonte: ponteiro da fonte entre a ligação.
@@ -0,0 +1,221 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#include "paralelo.h"
+
+/* Abaixo disto a ordenacao e sequencial: criar threads custa mais */
+#define ORDENA_MINIMO 16384
+
+typedef struct execucao
+{
+    void (*tarefa)(void *contexto, int i);
+    void *contexto;
+    int num_tarefas;
+    int proxima;                /*!< Proxima tarefa a ser distribuida */
+    pthread_mutex_t trava;
+} execucao_t;
+
+int paralelo_num_threads(void)
+{
+    long nucleos = sysconf(_SC_NPROCESSORS_ONLN);
+
+    return nucleos > 0 ? (int)nucleos : 1;
+}
+
+static void *executa(void *arg)
+{
+    execucao_t *e = arg;
+    int i;
+
+    for (;;)
+    {
+        pthread_mutex_lock(&e->trava);
+        i = e->proxima++;
+        pthread_mutex_unlock(&e->trava);
+
+        if (i >= e->num_tarefas)
+            return NULL;
+
+        e->tarefa(e->contexto, i);
+    }
+}
+
+/**
+  * @brief  Executa tarefas independentes em paralelo
+  * @param	num_threads: número máximo de threads (0: uma por núcleo)
+  * @param  num_tarefas: tarefas numeradas de 0 a num_tarefas - 1
+  * @param  tarefa: função executada para cada tarefa
+  * @param  contexto: repassado a tarefa
+  *
+  * As tarefas são distribuídas sob demanda, de modo que tarefas de custos
+  * diferentes se equilibram entre as threads.
+  *
+  * @retval Nenhum
+  */
+void paralelo_executa(int num_threads, int num_tarefas,
+                      void (*tarefa)(void *contexto, int i), void *contexto)
+{
+    execucao_t e;
+    pthread_t *threads;
+    int i;
+
+    if (tarefa == NULL || num_threads < 0)
+    {
+        fprintf(stderr, "paralelo_executa: parametros invalidos\n");
+        exit(EXIT_FAILURE);
+    }
+
+    if (num_threads == 0)
+        num_threads = paralelo_num_threads();
+    if (num_threads > num_tarefas)
+        num_threads = num_tarefas;
+
+    if (num_threads <= 1)
+    {
+        for (i = 0; i < num_tarefas; i++)
+            tarefa(contexto, i);
+        return;
+    }
+
+    e.tarefa = tarefa;
+    e.contexto = contexto;
+    e.num_tarefas = num_tarefas;
+    e.proxima = 0;
+    pthread_mutex_init(&e.trava, NULL);
+
+    threads = malloc((num_threads - 1) * sizeof(pthread_t));
+    if (threads == NULL)
+    {
+        perror("paralelo_executa:");
+        exit(EXIT_FAILURE);
+    }
+
+    for (i = 0; i < num_threads - 1; i++)
+        if (pthread_create(&threads[i], NULL, executa, &e) != 0)
+        {
+            fprintf(stderr, "paralelo_executa: falha ao criar thread\n");
+            exit(EXIT_FAILURE);
+        }
+
+    executa(&e);
+
+    for (i = 0; i < num_threads - 1; i++)
+        pthread_join(threads[i], NULL);
+
+    pthread_mutex_destroy(&e.trava);
+    free(threads);
+}
+
+typedef struct ordenacao
+{
+    char *origem;
+    char *destino;
+    size_t n;
+    size_t tamanho;
+    size_t bloco;               /*!< Elementos por bloco na rodada atual */
+    int (*compara)(const void *, const void *);
+} ordenacao_t;
+
+static void ordena_bloco(void *contexto, int i)
+{
+    ordenacao_t *o = contexto;
+    size_t inicio = i * o->bloco;
+    size_t fim = inicio + o->bloco < o->n ? inicio + o->bloco : o->n;
+
+    if (inicio >= o->n)
+        return;
+
+    qsort(o->origem + inicio * o->tamanho, fim - inicio, o->tamanho, o->compara);
+}
+
+/* Intercala os blocos 2i e 2i+1 de origem em destino */
+static void intercala_par(void *contexto, int i)
+{
+    ordenacao_t *o = contexto;
+    size_t t = o->tamanho;
+    size_t inicio = 2 * i * o->bloco;
+    size_t meio = inicio + o->bloco < o->n ? inicio + o->bloco : o->n;
+    size_t fim = meio + o->bloco < o->n ? meio + o->bloco : o->n;
+    size_t a = inicio, b = meio, k = inicio;
+
+    while (a < meio && b < fim)
+    {
+        if (o->compara(o->origem + b * t, o->origem + a * t) < 0)
+            memcpy(o->destino + t * k++, o->origem + t * b++, t);
+        else
+            memcpy(o->destino + t * k++, o->origem + t * a++, t);
+    }
+
+    memcpy(o->destino + t * k, o->origem + t * a, t * (meio - a));
+    k += meio - a;
+    memcpy(o->destino + t * k, o->origem + t * b, t * (fim - b));
+}
+
+/**
+  * @brief  Ordena um vetor em paralelo
+  * @param	base, n, tamanho, compara: como em qsort
+  * @param  num_threads: número máximo de threads (0: uma por núcleo)
+  *
+  * Cada thread ordena um bloco com qsort; os blocos ordenados são
+  * intercalados dois a dois, dobrando de tamanho a cada rodada.
+  * Usa um vetor auxiliar de n elementos.
+  *
+  * @retval Nenhum
+  */
+void paralelo_ordena(void *base, size_t n, size_t tamanho,
+                     int (*compara)(const void *, const void *), int num_threads)
+{
+    ordenacao_t o;
+    char *auxiliar, *troca;
+    int blocos;
+
+    if (compara == NULL || num_threads < 0)
+    {
+        fprintf(stderr, "paralelo_ordena: parametros invalidos\n");
+        exit(EXIT_FAILURE);
+    }
+
+    if (num_threads == 0)
+        num_threads = paralelo_num_threads();
+
+    if (num_threads <= 1 || n < ORDENA_MINIMO)
+    {
+        qsort(base, n, tamanho, compara);
+        return;
+    }
+
+    auxiliar = malloc(n * tamanho);
+    if (auxiliar == NULL)
+    {
+        perror("paralelo_ordena:");
+        exit(EXIT_FAILURE);
+    }
+
+    o.origem = base;
+    o.destino = auxiliar;
+    o.n = n;
+    o.tamanho = tamanho;
+    o.compara = compara;
+    o.bloco = (n + num_threads - 1) / num_threads;
+
+    paralelo_executa(num_threads, num_threads, ordena_bloco, &o);
+
+    while (o.bloco < n)
+    {
+        blocos = (int)((n + o.bloco - 1) / o.bloco);
+        paralelo_executa(num_threads, (blocos + 1) / 2, intercala_par, &o);
+
+        troca = o.origem;
+        o.origem = o.destino;
+        o.destino = troca;
+        o.bloco *= 2;
+    }
+
+    if (o.origem != base)
+        memcpy(base, o.origem, n * tamanho);
+
+    free(auxiliar);
+}
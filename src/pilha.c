@@ -1,38 +1,68 @@
 #include <stdlib.h>
 #include <stdio.h>
 
-#include "no.h"
 #include "pilha.h"
-#include "lista_enc.h"
 
 //#define DEBUG
 
 #define FALSO 0
 #define VERDADEIRO 1
 
+/* Capacidade de cria_pilha */
+#define PILHA_CAPACIDADE_INICIAL 16
+
 struct pilhas {
-	lista_enc_t *dados;     /*!< Lista encadeada que contém os dados empilhados */
+	void **dados;       /*!< Vetor com os dados empilhados, topo no fim */
+	int capacidade;
+	int topo;           /*!< Numero de dados empilhados */
 };
 
 /**
-  * @brief  Cria uma nova pilha genérica
+  * @brief  Cria uma nova pilha genérica com capacidade inicial
+  * @param capacidade: número de dados que cabem sem realocação
   *
   * @retval pilha_t: ponteiro para uma nova pilha
   */
-pilha_t * cria_pilha (void)
+pilha_t * cria_pilha_tamanho (int capacidade)
 {
-    pilha_t *pilha = (pilha_t*)malloc(sizeof(pilha_t));
+    pilha_t *pilha;
+
+    if (capacidade < 0) {
+        fprintf(stderr, "cria_pilha: capacidade invalida\n");
+        exit(EXIT_FAILURE);
+    }
+
+    if (capacidade == 0)
+        capacidade = 1;
 
+    pilha = (pilha_t*)malloc(sizeof(pilha_t));
     if (pilha == NULL) {
         fprintf(stderr, "Erro alocando dados em cria_pilha!\n");
         exit(EXIT_FAILURE);
     }
 
-    pilha->dados = cria_lista_enc();
+    pilha->dados = malloc(capacidade * sizeof(void*));
+    if (pilha->dados == NULL) {
+        fprintf(stderr, "Erro alocando dados em cria_pilha!\n");
+        exit(EXIT_FAILURE);
+    }
+
+    pilha->capacidade = capacidade;
+    pilha->topo = 0;
 
     return pilha;
 }
 
+/**
+  * @brief  Cria uma nova pilha genérica
+  *
+  * @retval pilha_t: ponteiro para uma nova pilha
+  */
+pilha_t * cria_pilha (void)
+{
+    return cria_pilha_tamanho(PILHA_CAPACIDADE_INICIAL);
+}
+
 /**
   * @brief  Empilha um dado
   * @param dado: referência do dado (ponteiro) a ser adicionado na pilha
@@ -42,7 +72,7 @@ pilha_t * cria_pilha (void)
   */
 void push(void* dado, pilha_t *pilha)
 {
-	no_t *no;
+	void **novo;
 
     if (pilha == NULL) {
         fprintf(stderr, "push: pilha invalida\n");
@@ -50,11 +80,20 @@ void push(void* dado, pilha_t *pilha)
     }
 
     #ifdef DEBUG
-    printf("push: %x\n", dado);
+    printf("push: %p\n", dado);
     #endif // DEBUG
 
-    no = cria_no(dado);
-    add_cauda(pilha->dados, no);
+    if (pilha->topo == pilha->capacidade) {
+        novo = realloc(pilha->dados, 2 * pilha->capacidade * sizeof(void*));
+        if (novo == NULL) {
+            fprintf(stderr, "Erro alocando dados em push!\n");
+            exit(EXIT_FAILURE);
+        }
+        pilha->dados = novo;
+        pilha->capacidade *= 2;
+    }
+
+    pilha->dados[pilha->topo++] = dado;
 }
 
 /**
@@ -65,23 +104,21 @@ void push(void* dado, pilha_t *pilha)
   */
 void *pop(pilha_t *pilha)
 {
-	no_t *no;
-	void *dado;
-
     if (pilha == NULL){
         fprintf(stderr, "pop: pilha invalida!\n");
         exit(EXIT_FAILURE);
     }
 
+    if (pilha->topo == 0){
+        fprintf(stderr, "pop: pilha vazia!\n");
+        exit(EXIT_FAILURE);
+    }
+
     #ifdef DEBUG
-    //printf("pop: %d\n", pilha->data[topo - 1]);
+    printf("pop: %p\n", pilha->dados[pilha->topo - 1]);
     #endif // DEBUG
 
-    no = remover_cauda(pilha->dados);
-    dado = obter_dado(no);
-    free(no);
-
-    return dado;
+    return pilha->dados[--pilha->topo];
 }
 
 
@@ -98,7 +135,7 @@ void libera_pilha(pilha_t* pilha)
         exit(EXIT_FAILURE);
     }
 
-    if (!lista_vazia(pilha->dados))    {
+    if (pilha->topo > 0)    {
     	fprintf(stderr, "Impossivel liberar pilha, ainda ha dados\n");
     	exit(EXIT_FAILURE);
     }
@@ -121,5 +158,21 @@ int pilha_vazia(pilha_t *pilha)
         exit(EXIT_FAILURE);
     }
 
-    return lista_vazia(pilha->dados);
+    return pilha->topo == 0 ? VERDADEIRO : FALSO;
+}
+
+/**
+  * @brief Retorna o número de dados na pilha
+  * @param pilha: pilha criada
+  *
+  * @retval int: número de dados empilhados
+  */
+int pilha_tamanho(pilha_t *pilha)
+{
+    if (pilha == NULL) {
+        fprintf(stderr, "pilha_tamanho: pilha invalida\n");
+        exit(EXIT_FAILURE);
+    }
+
+    return pilha->topo;
 }
@@ -0,0 +1,175 @@
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "tabela_hash.h"
+
+/* Ocupacao maxima: tamanho <= capacidade / 2 */
+#define CAPACIDADE_MINIMA 16
+
+typedef struct entrada {
+    int chave;
+    int valor;      /*!< HASH_AUSENTE indica posicao livre */
+} entrada_t;
+
+struct tabelas_hash {
+    entrada_t *entradas;    /*!< Vetor com capacidade potencia de dois */
+    int capacidade;
+    int deslocamento;       /*!< 32 - log2(capacidade) */
+    int tamanho;
+};
+
+/* Hash multiplicativo de Fibonacci: os bits altos do produto dependem de
+ * todos os bits da chave; os baixos, so dos bits baixos dela */
+static unsigned int espalha(int chave, int deslocamento)
+{
+    return ((unsigned int) chave * 2654435769u) >> deslocamento;
+}
+
+/* Capacidade minima 16: o deslocamento nunca chega a 32 */
+static int calcula_deslocamento(int capacidade)
+{
+    int d = 32;
+
+    while (capacidade > 1) {
+        capacidade >>= 1;
+        d--;
+    }
+
+    return d;
+}
+
+static entrada_t *aloca_entradas(int capacidade)
+{
+    entrada_t *p = malloc(capacidade * sizeof(entrada_t));
+    int i;
+
+    if (p == NULL) {
+        perror("tabela_hash:");
+        exit(EXIT_FAILURE);
+    }
+
+    for (i = 0; i < capacidade; i++)
+        p[i].valor = HASH_AUSENTE;
+
+    return p;
+}
+
+/**
+  * @brief  Cria uma tabela hash vazia
+  * @param  capacidade: número de chaves esperado (a tabela cresce se necessário)
+  *
+  * @retval tabela_hash_t: ponteiro para a nova tabela
+  */
+tabela_hash_t *cria_tabela_hash(int capacidade)
+{
+    tabela_hash_t *p = malloc(sizeof(tabela_hash_t));
+    int c = CAPACIDADE_MINIMA;
+
+    if (p == NULL) {
+        perror("cria_tabela_hash:");
+        exit(EXIT_FAILURE);
+    }
+
+    while (c < 2 * capacidade)
+        c <<= 1;
+
+    p->capacidade = c;
+    p->deslocamento = calcula_deslocamento(c);
+    p->tamanho = 0;
+    p->entradas = aloca_entradas(c);
+
+    return p;
+}
+
+static entrada_t *procura_posicao(entrada_t *entradas, int capacidade, int deslocamento,
+                                  int chave)
+{
+    unsigned int i = espalha(chave, deslocamento);
+
+    while (entradas[i].valor != HASH_AUSENTE && entradas[i].chave != chave)
+        i = (i + 1) & (unsigned int) (capacidade - 1);
+
+    return &entradas[i];
+}
+
+static void redimensiona(tabela_hash_t *tabela)
+{
+    entrada_t *antigas = tabela->entradas, *e;
+    int antiga_capacidade = tabela->capacidade, i;
+
+    tabela->capacidade *= 2;
+    tabela->deslocamento--;
+    tabela->entradas = aloca_entradas(tabela->capacidade);
+
+    for (i = 0; i < antiga_capacidade; i++) {
+        if (antigas[i].valor == HASH_AUSENTE)
+            continue;
+        e = procura_posicao(tabela->entradas, tabela->capacidade, tabela->deslocamento,
+                            antigas[i].chave);
+        *e = antigas[i];
+    }
+
+    free(antigas);
+}
+
+/**
+  * @brief  Associa valor à chave
+  * @param  tabela: tabela hash
+  * @param  chave: chave inteira qualquer
+  * @param  valor: valor não negativo
+  *
+  * @retval Nenhum
+  */
+void tabela_hash_inserir(tabela_hash_t *tabela, int chave, int valor)
+{
+    entrada_t *e;
+
+    if (tabela == NULL || valor < 0) {
+        fprintf(stderr, "tabela_hash_inserir: parametros invalidos\n");
+        exit(EXIT_FAILURE);
+    }
+
+    if (2 * (tabela->tamanho + 1) > tabela->capacidade)
+        redimensiona(tabela);
+
+    e = procura_posicao(tabela->entradas, tabela->capacidade, tabela->deslocamento, chave);
+    if (e->valor == HASH_AUSENTE)
+        tabela->tamanho++;
+
+    e->chave = chave;
+    e->valor = valor;
+}
+
+/**
+  * @brief  Busca o valor associado à chave
+  * @param  tabela: tabela hash
+  * @param  chave: chave procurada
+  *
+  * @retval int: valor associado ou HASH_AUSENTE
+  */
+int tabela_hash_buscar(tabela_hash_t *tabela, int chave)
+{
+    if (tabela == NULL) {
+        fprintf(stderr, "tabela_hash_buscar: tabela invalida\n");
+        exit(EXIT_FAILURE);
+    }
+
+    return procura_posicao(tabela->entradas, tabela->capacidade, tabela->deslocamento,
+                           chave)->valor;
+}
+
+int tabela_hash_tamanho(tabela_hash_t *tabela)
+{
+    return tabela->tamanho;
+}
+
+void libera_tabela_hash(tabela_hash_t *tabela)
+{
+    if (tabela == NULL) {
+        fprintf(stderr, "libera_tabela_hash: tabela invalida\n");
+        exit(EXIT_FAILURE);
+    }
+
+    free(tabela->entradas);
+    free(tabela);
+}
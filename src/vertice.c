@@ -13,8 +13,10 @@
 
 struct vertices {
 	int id;
+	int indice;			/* Posicao densa do vertice no grafo: [0, V) */
 	char *nome;
 	lista_enc_t *arestas;
+	pool_t *pool_nos;	/* Origem dos nos de arestas. NULL: malloc */
 
 	/* Informacoes para componentes conexos */
 	int id_grupo;
@@ -35,6 +37,18 @@ struct arestas {
 };
 
 
+static void inicia_vertice(vertice_t *p, int id)
+{
+	p->id = id;
+	p->indice = -1;
+	p->nome = NULL;
+	p->id_grupo = -1;
+	p->dist = 0;
+	p->visitado = 0;
+	p->pai = NULL;
+	p->antecessor_caminho = NULL;
+}
+
 vertice_t *cria_vertice(int id)
 {
 	vertice_t *p = NULL;
@@ -46,10 +60,20 @@ vertice_t *cria_vertice(int id)
 		exit(EXIT_FAILURE);
 	}
 
-	p->id = id;
 	p->arestas = cria_lista_enc();
-	p->id_grupo = -1;
-	p->pai = NULL;
+	p->pool_nos = NULL;
+	inicia_vertice(p, id);
+
+	return p;
+}
+
+vertice_t *cria_vertice_arena(arena_t *arena, pool_t *pool_nos, int id)
+{
+	vertice_t *p = arena_aloca(arena, sizeof(vertice_t));
+
+	p->arestas = cria_lista_enc_arena(arena);
+	p->pool_nos = pool_nos;
+	inicia_vertice(p, id);
 
 	return p;
 }
@@ -65,6 +89,28 @@ int vertice_get_id(vertice_t *vertice)
 	return vertice->id;
 }
 
+void vertice_set_indice(vertice_t *vertice, int indice)
+{
+	if (vertice == NULL)
+	{
+		fprintf(stderr, "vertice_set_indice: vertice invalido!\n");
+		exit(EXIT_FAILURE);
+	}
+
+	vertice->indice = indice;
+}
+
+int vertice_get_indice(vertice_t *vertice)
+{
+	if (vertice == NULL)
+	{
+		fprintf(stderr, "vertice_get_indice: vertice invalido!\n");
+		exit(EXIT_FAILURE);
+	}
+
+	return vertice->indice;
+}
+
 void vertice_set_nome(vertice_t *vertice, char *nome)
 {
 	vertice->nome = nome;
@@ -89,10 +135,28 @@ arestas_t *cria_aresta(vertice_t *fonte, vertice_t *destino, float peso)
 	p->peso = peso;
 	p->fonte = fonte;
 	p->dest = destino;
+	p->status = VAZIO;
+
+	return p;
+}
+
+arestas_t *cria_aresta_pool(pool_t *pool, vertice_t *fonte, vertice_t *destino, float peso)
+{
+	arestas_t *p = pool_aloca(pool);
+
+	p->peso = peso;
+	p->fonte = fonte;
+	p->dest = destino;
+	p->status = VAZIO;
 
 	return p;
 }
 
+size_t tamanho_aresta(void)
+{
+	return sizeof(arestas_t);
+}
+
 void adiciona_aresta(vertice_t *vertice, arestas_t *aresta)
 {
 	no_t *no;
@@ -102,7 +166,7 @@ void adiciona_aresta(vertice_t *vertice, arestas_t *aresta)
 		exit(EXIT_FAILURE);
 	}
 
-	no = cria_no(aresta);
+	no = vertice->pool_nos ? cria_no_pool(vertice->pool_nos, aresta) : cria_no(aresta);
 	add_cauda(vertice->arestas, no);
 
 }
@@ -295,8 +359,8 @@ float vertices_comprimento(vertice_t *fonte, vertice_t *destino)
 
 void vertice_set_antec_caminho(vertice_t *vertice, vertice_t *antecessor){
 
-	if (vertice == NULL || antecessor == NULL){
-		fprintf(stderr, "vertice_set_antec_caminho: vertices invalidos\n");
+	if (vertice == NULL){
+		fprintf(stderr, "vertice_set_antec_caminho: vertice invalido\n");
 		exit(EXIT_FAILURE);
 	}
 